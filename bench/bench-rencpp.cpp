@@ -0,0 +1,425 @@
+//
+// bench-rencpp.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+//
+// Times the binding's hot paths and writes the results as JSON, so that
+// runs from two commits can be diffed:
+//
+//     bench-rencpp [--out file] [--filter text] [--min-time seconds]
+//
+// Each benchmark is run with a doubling count of operations until one run
+// takes at least the minimum time (a quarter second by default), and the
+// time per operation of that run is reported.  Only benchmarks with the
+// filter text in their name are run.  A benchmark that throws (as many do
+// on the fake Red runtime, which constructs only a few kinds of value) is
+// listed as skipped, with the exception's message.
+//
+// The fake Red runtime also prints a trace of what it is asked to do, so
+// give it --out to keep the JSON separate.
+//
+// The output has no timestamps or host details, so that it only differs
+// where the numbers do:
+//
+//     {
+//         "runtime": "rebol",
+//         "benchmarks": [
+//             {"name": "construct/integer", "operations": 4194304,
+//                 "ns_per_op": 21.7},
+//             {"name": "gc/recycle/live=100000", "skipped": "..."},
+//             ...
+//         ]
+//     }
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "rencpp/ren.hpp"
+
+using namespace ren;
+
+namespace {
+
+//
+// HARNESS
+//
+
+struct Measurement {
+    std::string name;
+    uint64_t operations;
+    double seconds;
+    std::string skipped; // the reason, if not run
+};
+
+
+class Bench {
+private:
+    std::string filter;
+    double minSeconds;
+    std::vector<Measurement> measurements;
+
+public:
+    Bench (std::string const & filter, double minSeconds) :
+        filter (filter),
+        minSeconds (minSeconds)
+    {
+    }
+
+    // Times body(count), which is to perform count operations
+    template <class Body>
+    void run(std::string const & name, Body const & body) {
+        if (name.find(filter) == std::string::npos)
+            return;
+
+        std::cerr << name << "\n";
+
+        Measurement measurement {name, 0, 0, ""};
+        try {
+            body(1); // warm up, and find out if it works at all
+
+            for (uint64_t count = 1; ; count *= 2) {
+                auto start = std::chrono::steady_clock::now();
+                body(count);
+                std::chrono::duration<double> elapsed =
+                    std::chrono::steady_clock::now() - start;
+
+                if (
+                    elapsed.count() >= minSeconds
+                    or count >= (UINT64_C(1) << 40)
+                ) {
+                    measurement.operations = count;
+                    measurement.seconds = elapsed.count();
+                    break;
+                }
+            }
+        }
+        catch (std::exception const & e) {
+            measurement.skipped = e.what();
+            if (measurement.skipped.empty())
+                measurement.skipped = "exception";
+        }
+
+        measurements.push_back(measurement);
+    }
+
+    void writeJson(std::ostream & os, char const * runtimeName) const {
+        os << "{\n"
+            << "    \"runtime\": " << quoted(runtimeName) << ",\n"
+            << "    \"benchmarks\": [";
+
+        char const * separator = "\n";
+        for (auto const & measurement : measurements) {
+            os << separator << "        {\"name\": "
+                << quoted(measurement.name);
+
+            if (not measurement.skipped.empty()) {
+                os << ", \"skipped\": " << quoted(measurement.skipped);
+            }
+            else {
+                os << ", \"operations\": " << measurement.operations
+                    << ", \"ns_per_op\": " << std::setprecision(6)
+                    << measurement.seconds * 1e9 / measurement.operations;
+            }
+
+            os << "}";
+            separator = ",\n";
+        }
+
+        os << "\n    ]\n}\n";
+    }
+
+private:
+    static std::string quoted(std::string const & text) {
+        std::string result = "\"";
+        for (char c : text) {
+            switch (c) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    static char const hex[] = "0123456789abcdef";
+                    result += "\\u00";
+                    result += hex[(c >> 4) & 0xF];
+                    result += hex[c & 0xF];
+                }
+                else
+                    result += c;
+            }
+        }
+        return result + "\"";
+    }
+};
+
+
+// Keeps the compiler from dropping work whose result is unused
+
+volatile size_t sink;
+
+void consume(AnyValue const & value) {
+    sink = sink + static_cast<size_t>(value.isNone());
+}
+
+
+Block integerBlock(size_t length) {
+    std::vector<AnyValue> values;
+    values.reserve(length);
+    for (size_t index = 0; index < length; ++index)
+        values.push_back(Integer {static_cast<int>(index)});
+
+    // Parentheses, as braces would be taken as an initializer list
+    return Block (values.data(), values.size(), static_cast<Engine *>(nullptr));
+}
+
+
+
+//
+// BENCHMARKS
+//
+
+void benchConstruction(Bench & bench) {
+    bench.run("construct/none", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            consume(None {});
+    });
+
+    bench.run("construct/logic", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            consume(Logic {index % 2 == 0});
+    });
+
+    bench.run("construct/character", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            consume(Character {'x'});
+    });
+
+    bench.run("construct/integer", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            consume(Integer {static_cast<int>(index)});
+    });
+
+    bench.run("construct/float", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            consume(Float {static_cast<double>(index)});
+    });
+
+    bench.run("construct/date", [](uint64_t count) {
+        auto now = std::chrono::system_clock::now();
+        for (uint64_t index = 0; index < count; ++index)
+            consume(Date {now});
+    });
+
+    bench.run("construct/time", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            consume(Time {std::chrono::seconds {90}});
+    });
+
+    bench.run("construct/pair", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            consume(Pair {640, 480});
+    });
+
+    bench.run("construct/tuple", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            consume(Tuple {1, 2, 3});
+    });
+
+    bench.run("construct/word", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            consume(Word {"hedgehog"});
+    });
+
+    bench.run("construct/string", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            consume(String {"Hello World"});
+    });
+
+    bench.run("construct/block", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            consume(Block {1, 2, 3});
+    });
+
+    bench.run("construct/block-loaded", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            consume(Block {"1 2 3"});
+    });
+}
+
+
+void benchEvaluation(Bench & bench) {
+    bench.run("runtime/literal", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            runtime("1 + 2");
+    });
+
+    bench.run("runtime/values", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            runtime("add", 1, 2);
+    });
+
+    bench.run("runtime/try-error", [](uint64_t count) {
+        for (uint64_t index = 0; index < count; ++index)
+            runtime.tryEvaluate({"do make error! {Hedgehog}"});
+    });
+}
+
+
+void benchFunction(Bench & bench) {
+    // Both loops are run by the runtime, so the difference between them is
+    // what the binding adds per call (the shim bounce, the table lookup,
+    // and marshaling of the argument and result)
+
+    // Made by the first (untimed) call, so a runtime that can't make one
+    // only skips this benchmark
+    optional<Function> trivial;
+
+    bench.run("function/native", [&trivial](uint64_t count) {
+        if (trivial == nullopt)
+            trivial = Function::construct(
+                "{Returns its argument}"
+                "value [integer!]",
+
+                [](Integer const & value) -> Integer {
+                    return value;
+                }
+            );
+
+        runtime("loop", static_cast<int>(count), Block {*trivial, 1});
+    });
+
+    bench.run("function/builtin", [](uint64_t count) {
+        runtime("loop", static_cast<int>(count), Block {"negate 1"});
+    });
+}
+
+
+void benchSeries(Bench & bench) {
+    static size_t const lengths[] = {10, 1000, 100000};
+    for (size_t length : lengths) {
+        std::string suffix = "/" + std::to_string(length);
+
+        bench.run("to_string" + suffix, [length](uint64_t count) {
+            Block block = integerBlock(length);
+            for (uint64_t index = 0; index < count; ++index)
+                sink = sink + to_string(block).size();
+        });
+    }
+
+    bench.run("series/iterate", [](uint64_t count) {
+        size_t const length = 1000;
+        Block block = integerBlock(length);
+        uint64_t done = 0;
+        while (done < count) {
+            for (auto value : block) {
+                consume(value);
+                if (++done == count)
+                    break;
+            }
+        }
+    });
+
+    bench.run("series/index", [](uint64_t count) {
+        size_t const length = 1000;
+        Block block = integerBlock(length);
+        for (uint64_t index = 0; index < count; ++index)
+            consume(block[static_cast<int>(index % length) + 1]);
+    });
+}
+
+
+void benchGarbageCollection(Bench & bench) {
+    // The host's share of a recycle is marking every value it holds (on
+    // Rebol, Queue_Mark_Host_Deep).  That can't be timed on its own from
+    // outside the binding, so recycles are timed with different numbers of
+    // live values; the growth over live=0 is what the marking costs.
+
+    static size_t const lives[] = {0, 1000, 100000};
+    for (size_t live : lives) {
+        std::string name = "gc/recycle/live=" + std::to_string(live);
+
+        bench.run(name, [live](uint64_t count) {
+            std::vector<AnyValue> values;
+            values.reserve(live);
+            for (size_t index = 0; index < live; ++index)
+                values.push_back(Block {});
+
+            for (uint64_t index = 0; index < count; ++index)
+                runtime("recycle");
+        });
+    }
+}
+
+} // end anonymous namespace
+
+
+int main(int argc, char ** argv) {
+    std::string out;
+    std::string filter;
+    double minSeconds = 0.25;
+
+    for (int index = 1; index < argc; ++index) {
+        bool hasArgument = index + 1 < argc;
+
+        if (std::strcmp(argv[index], "--out") == 0 and hasArgument)
+            out = argv[++index];
+        else if (std::strcmp(argv[index], "--filter") == 0 and hasArgument)
+            filter = argv[++index];
+        else if (std::strcmp(argv[index], "--min-time") == 0 and hasArgument)
+            minSeconds = std::atof(argv[++index]);
+        else {
+            std::cerr << "usage: " << argv[0]
+                << " [--out file] [--filter text] [--min-time seconds]\n";
+            return 1;
+        }
+    }
+
+    Bench bench {filter, minSeconds};
+
+    benchConstruction(bench);
+    benchEvaluation(bench);
+    benchFunction(bench);
+    benchSeries(bench);
+    benchGarbageCollection(bench);
+
+#if REN_RUNTIME == REN_RUNTIME_RED
+    char const * runtimeName = "red";
+#else
+    char const * runtimeName = "rebol";
+#endif
+
+    if (out.empty()) {
+        bench.writeJson(std::cout, runtimeName);
+        return 0;
+    }
+
+    std::ofstream file {out};
+    bench.writeJson(file, runtimeName);
+    if (not file) {
+        std::cerr << "couldn't write " << out << "\n";
+        return 1;
+    }
+    return 0;
+}
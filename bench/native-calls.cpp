@@ -0,0 +1,99 @@
+//
+// native-calls.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+//
+// Measures how many times per second a trivial ren::Function can be called
+// from a loop in the runtime.  The cost of the same loop running a trivial
+// built-in is subtracted, to leave what the binding adds per call: the
+// shim bounce, the table lookup, argument and result marshaling.  The same
+// function constructed directly (without REN_STD_FUNCTION) is also timed.
+//
+//     bench-native-calls [iterations]
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "rencpp/ren.hpp"
+
+using namespace ren;
+
+namespace {
+
+double secondsToRun(int iterations, char const * body) {
+    auto start = std::chrono::steady_clock::now();
+    runtime("loop", iterations, Block {body});
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // end anonymous namespace
+
+
+int main(int argc, char ** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    auto trivial = Function::construct(
+        "{Returns its argument}"
+        "value [integer!]",
+
+        REN_STD_FUNCTION,
+
+        [](Integer const & value) -> Integer {
+            return value;
+        }
+    );
+
+    auto direct = Function::construct(
+        "{Returns its argument}"
+        "value [integer!]",
+
+        [](Integer const & value) -> Integer {
+            return value;
+        }
+    );
+
+    runtime("bench-native: quote", trivial);
+    runtime("bench-direct: quote", direct);
+
+    // Warm up once so that one-time costs (engine startup, first shim call)
+    // are not counted.
+
+    secondsToRun(1000, "bench-native 1");
+    secondsToRun(1000, "bench-direct 1");
+
+    double native = secondsToRun(iterations, "bench-native 1");
+    double directNative = secondsToRun(iterations, "bench-direct 1");
+    double builtin = secondsToRun(iterations, "negate 1");
+
+    double overhead = native - builtin;
+    double directOverhead = directNative - builtin;
+
+    std::cout << "iterations: " << iterations << "\n"
+        << "native calls/sec: " << iterations / native << "\n"
+        << "direct native calls/sec: " << iterations / directNative << "\n"
+        << "builtin calls/sec: " << iterations / builtin << "\n"
+        << "binding overhead per call (ns): "
+        << (overhead * 1e9) / iterations << "\n"
+        << "direct binding overhead per call (ns): "
+        << (directOverhead * 1e9) / iterations << "\n";
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+//
+// zygote-start.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+//
+// Compares the latency of getting an answer from a fresh engine two ways:
+// cold, by starting a new process that boots the runtime and evaluates
+// (this program, re-run with --cold), and from a ren::Zygote that forks a
+// pre-booted child for each evaluation.
+//
+//     bench-zygote-start [iterations]
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "rencpp/ren.hpp"
+#include "rencpp/pool.hpp"
+
+using namespace ren;
+
+namespace {
+
+char const * probe = "1 + 2";
+
+double coldStartSeconds(char * self) {
+    auto start = std::chrono::steady_clock::now();
+
+    pid_t child = fork();
+    if (child == 0) {
+        char cold[] = "--cold";
+        char * args[] = {self, cold, nullptr};
+        execv(self, args);
+        _exit(127);
+    }
+
+    int status;
+    waitpid(child, &status, 0);
+    if (not WIFEXITED(status) or WEXITSTATUS(status) != 0) {
+        std::cerr << "cold start child failed\n";
+        std::exit(1);
+    }
+
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+double zygoteStartSeconds(Zygote & zygote) {
+    auto start = std::chrono::steady_clock::now();
+    zygote.run(probe);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // end anonymous namespace
+
+
+int main(int argc, char ** argv) {
+    if (argc > 1 and std::strcmp(argv[1], "--cold") == 0) {
+        runtime(probe);
+        return 0;
+    }
+
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 100;
+
+    double cold = 0;
+    for (int index = 0; index < iterations; ++index)
+        cold += coldStartSeconds(argv[0]);
+
+    Zygote zygote;
+    zygoteStartSeconds(zygote); // warm up
+
+    double warm = 0;
+    for (int index = 0; index < iterations; ++index)
+        warm += zygoteStartSeconds(zygote);
+
+    std::cout << "iterations: " << iterations << "\n"
+        << "cold start latency (us): " << (cold * 1e6) / iterations << "\n"
+        << "zygote start latency (us): " << (warm * 1e6) / iterations << "\n";
+
+    return 0;
+}
@@ -0,0 +1,50 @@
+#
+# embed-startup-scripts.cmake
+#
+# Run in script mode by the embed_startup_scripts() function in the top
+# level CMakeLists.txt, which see.  Writes a C++ file holding the bytes of
+# each prescanned script in SCRIPTS (separated by |) as arrays, registered
+# with ren::addStartupScript() under the matching name in NAMES.
+#
+#     cmake -DSCRIPTS="a.bin|b.bin" -DNAMES="a.reb|b.reb" \
+#         -DOUTPUT=startup-scripts.cpp -P <this>
+#
+# The output is only touched if its contents change, so editing a script
+# only rebuilds the one generated file.
+#
+
+set(CONTENTS "// Generated by embed-startup-scripts.cmake, do not edit\n\n")
+set(CONTENTS "${CONTENTS}#include \"rencpp/startup.hpp\"\n\nnamespace {\n")
+
+string(REPLACE "|" ";" SCRIPTS "${SCRIPTS}")
+string(REPLACE "|" ";" NAMES "${NAMES}")
+
+set(INDEX 0)
+foreach(SCRIPT ${SCRIPTS})
+    list(GET NAMES ${INDEX} NAME)
+    file(READ ${SCRIPT} HEX HEX)
+
+    # One "0x.., " per byte, with a line break every 16 bytes (CMake's regex
+    # has no {n} repetition, so the pattern for a line is spelled out)
+    string(REGEX REPLACE
+        "([0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f])"
+        "\\1\n    " HEX "${HEX}"
+    )
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1, " HEX "${HEX}")
+    string(REGEX REPLACE ",[ \n]*$" "" HEX "${HEX}")
+    string(REPLACE ", \n" ",\n" HEX "${HEX}")
+
+    set(CONTENTS "${CONTENTS}\n// ${NAME}\n\n")
+    set(CONTENTS "${CONTENTS}unsigned char const script${INDEX}[] = {\n    ${HEX}\n};\n\n")
+    set(CONTENTS "${CONTENTS}ren::StartupScript register${INDEX} {\n    \"${NAME}\", script${INDEX}, sizeof(script${INDEX})\n};\n")
+
+    math(EXPR INDEX "${INDEX} + 1")
+endforeach()
+
+set(CONTENTS "${CONTENTS}\n} // end anonymous namespace\n")
+
+file(WRITE ${OUTPUT}.tmp "${CONTENTS}")
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E copy_if_different ${OUTPUT}.tmp ${OUTPUT}
+)
+file(REMOVE ${OUTPUT}.tmp)
@@ -19,6 +19,9 @@
 // See http://rencpp.hostilefork.com for more information on this project
 //
 
+#include <chrono>
+#include <initializer_list>
+
 #include "value.hpp"
 
 //
@@ -254,9 +257,11 @@ public:
 //
 //     http://stackoverflow.com/questions/6730422/
 //
-// Hesitant to put in a dependency just for that.  If you want to extract
-// information from the date you can do that with calls into the
-// evaluator.
+// Hesitant to put in a dependency just for that.  So a Date can be made
+// from a system_clock::time_point (which comes back in UTC), or from a
+// year, month, and day for dates outside what the clock can represent.
+// Both write the cell directly instead of going through the scanner.
+// For anything more involved you can make calls into the evaluator.
 //
 
 class Date : public Atom {
@@ -270,6 +275,116 @@ public:
         std::string const & str,
         Engine * engine = nullptr
     );
+
+    explicit Date (
+        std::chrono::system_clock::time_point when,
+        Engine * engine = nullptr
+    );
+
+    // Throws std::out_of_range for a month or day the calendar doesn't have,
+    // or a year the runtime can't hold
+    Date (int year, int month, int day, Engine * engine = nullptr);
+
+    int year() const;
+    int month() const;
+    int day() const;
+
+    // A date with no time is taken as midnight, and one with a zone is
+    // adjusted to UTC.  Throws std::out_of_range if the clock can't
+    // represent the date.
+    explicit operator std::chrono::system_clock::time_point () const;
+};
+
+
+
+//
+// TIME
+//
+
+//
+// A TIME! is a duration (it may be negative, or more than a day), counted
+// in nanoseconds.  A std::chrono::duration of whole seconds, milliseconds,
+// etc. converts to nanoseconds implicitly so can be passed straight in;
+// a floating point one has to be duration_cast first.
+//
+
+class Time : public Atom {
+protected:
+    friend class AnyValue;
+    Time (Dont) noexcept : Atom (Dont::Initialize) {}
+    inline bool isValid() const { return isTime(); }
+
+public:
+    explicit Time (
+        std::chrono::nanoseconds duration,
+        Engine * engine = nullptr
+    );
+
+    operator std::chrono::nanoseconds () const;
+};
+
+
+
+//
+// PAIR
+//
+
+//
+// Rebol stores the coordinates of a PAIR! as single precision floats, so
+// they only come back exactly if they fit in one.
+//
+
+class Pair : public Atom {
+protected:
+    friend class AnyValue;
+    Pair (Dont) noexcept : Atom (Dont::Initialize) {}
+    inline bool isValid() const { return isPair(); }
+
+public:
+    Pair (double x, double y, Engine * engine = nullptr);
+
+    double x() const;
+    double y() const;
+};
+
+
+
+//
+// TUPLE
+//
+
+//
+// A TUPLE! is a short run of byte-sized numbers, like 1.2.3 or 255.0.0.
+// Constructing one with fewer than 3 or more than 10 components throws
+// std::length_error, as the runtime couldn't LOAD the result back.
+//
+
+class Tuple : public Atom {
+protected:
+    friend class AnyValue;
+    Tuple (Dont) noexcept : Atom (Dont::Initialize) {}
+    inline bool isValid() const { return isTuple(); }
+
+public:
+    Tuple (
+        unsigned char const components[],
+        size_t count,
+        Engine * engine = nullptr
+    );
+
+    Tuple (
+        std::initializer_list<unsigned char> components,
+        Engine * engine = nullptr
+    ) :
+        Tuple (components.begin(), components.size(), engine)
+    {
+    }
+
+    size_t size() const;
+
+    // Counts from 1, as series indexing and PICK do; throws
+    // std::out_of_range for 0 or an index past the last component
+    unsigned char operator[](size_t index) const;
 };
 
 
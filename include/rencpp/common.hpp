@@ -216,6 +216,104 @@ using extract_optional_t = typename extract_optional<T>::type;
 
 
 
+//
+// REN::STRING_VIEW
+//
+// Source text is often a slice of some bigger buffer--a line of a file, a
+// field of a network message--and making a std::string of it (or writing
+// a NUL into the buffer) just to load it is a waste.  std::string_view is
+// the type for that, but it only arrived in C++17.  So as with optional,
+// the binding names it `ren::string_view`: an alias for the standard one
+// where there is one, and otherwise a minimal stand-in with the parts of
+// its interface that the binding needs.
+//
+// Nothing is copied; the characters have to stay valid for as long as the
+// view is used.
+//
+
+#if __cplusplus >= 201703L
+
+#include <string_view>
+
+namespace ren {
+
+using string_view = std::string_view;
+
+} // end namespace ren
+
+#else
+
+#include <cstring>
+#include <string>
+
+namespace ren {
+
+class string_view {
+private:
+    char const * ptr;
+    size_t len;
+
+public:
+    constexpr string_view () noexcept :
+        ptr (nullptr),
+        len (0)
+    {
+    }
+
+    constexpr string_view (char const * data, size_t size) noexcept :
+        ptr (data),
+        len (size)
+    {
+    }
+
+    string_view (char const * cstr) :
+        ptr (cstr),
+        len (std::strlen(cstr))
+    {
+    }
+
+    string_view (std::string const & str) noexcept :
+        ptr (str.data()),
+        len (str.size())
+    {
+    }
+
+    constexpr char const * data() const noexcept { return ptr; }
+    constexpr size_t size() const noexcept { return len; }
+    constexpr size_t length() const noexcept { return len; }
+    constexpr bool empty() const noexcept { return len == 0; }
+
+    constexpr char const * begin() const noexcept { return ptr; }
+    constexpr char const * end() const noexcept { return ptr + len; }
+
+    constexpr char operator[](size_t index) const { return ptr[index]; }
+
+    string_view substr(size_t pos, size_t count = size_t(-1)) const {
+        if (pos > len)
+            throw std::out_of_range {"ren::string_view::substr"};
+        return string_view {ptr + pos, count < len - pos ? count : len - pos};
+    }
+
+    explicit operator std::string() const {
+        return std::string {ptr, len};
+    }
+
+    friend bool operator==(string_view left, string_view right) noexcept {
+        return left.len == right.len
+            and (left.len == 0 or std::memcmp(left.ptr, right.ptr, left.len) == 0);
+    }
+
+    friend bool operator!=(string_view left, string_view right) noexcept {
+        return not (left == right);
+    }
+};
+
+} // end namespace ren
+
+#endif
+
+
+
 namespace ren {
 
 namespace utility {
@@ -247,8 +345,15 @@ struct make_indices<0, Ind...>:
 // This is a clone of the proposed std::type_at
 //
 
+// (Left undefined for an empty pack, so that naming it is not an error
+// until the type is actually asked for; functions taking no arguments
+// have an arg<N> alias too.)
+
+template <unsigned N, typename... Ts>
+struct type_at;
+
 template <unsigned N, typename T, typename... R>
-struct type_at
+struct type_at<N, T, R...>
 {
     using type = typename type_at<N-1, R...>::type;
 };
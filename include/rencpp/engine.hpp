@@ -19,15 +19,92 @@
 // See http://rencpp.hostilefork.com for more information on this project
 //
 
+#include <chrono>
 #include <functional>
 #include <iostream>
 #include <stdexcept>
+#include <streambuf>
+#include <vector>
 
 #include "value.hpp"
 #include "runtime.hpp"
 
 namespace ren {
 
+class InputRing;
+
+
+//
+// OUTPUT BUFFERING
+//
+
+//
+// Output from the runtime (PRINT and friends, or ren::print) used to be
+// written and flushed to the engine's output stream on each call, which made
+// scripts that print in loops spend their time flushing.  It now builds up
+// in a buffer, and is passed on to the output stream and flushed when:
+//
+// * flushThreshold bytes have built up (zero passes on every write)
+// * a write comes flushInterval or more after the last flush
+// * the runtime is about to read input, if flushOnInput
+// * an evaluation returns to the host, or Engine::flushOutput() is called
+//
+// There is no timer thread, so output sitting in the buffer during a long
+// computation that doesn't print waits for one of the above.
+//
+
+struct OutputPolicy {
+    size_t flushThreshold;
+    std::chrono::milliseconds flushInterval;
+    bool flushOnInput;
+
+    OutputPolicy (
+        size_t flushThreshold = 4096,
+        std::chrono::milliseconds flushInterval = std::chrono::milliseconds {50},
+        bool flushOnInput = true
+    ) :
+        flushThreshold (flushThreshold),
+        flushInterval (flushInterval),
+        flushOnInput (flushOnInput)
+    {
+    }
+};
+
+
+namespace internal {
+
+class OutputBuffer : public std::streambuf {
+private:
+    std::ostream * target;
+    OutputPolicy policy;
+    std::vector<char> buffer;
+    std::chrono::steady_clock::time_point lastFlush;
+
+private:
+    bool passOn();
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(char const * data, std::streamsize count) override;
+    int sync() override;
+
+public:
+    explicit OutputBuffer (std::ostream & target);
+
+    void setTarget(std::ostream & newTarget);
+    void setPolicy(OutputPolicy const & newPolicy);
+
+    OutputPolicy const & getPolicy() const {
+        return policy;
+    }
+
+    // Only passes on to the target (and flushes it) if anything is pending
+    bool flush();
+};
+
+} // end namespace internal
+
+
 
 //
 // ENGINE OBJECT FOR SANDBOXING INTERPRETER STATE
@@ -71,6 +148,10 @@ private:
 private:
     std::ostream * osPtr;
     std::istream * isPtr;
+    InputRing * ringPtr;
+
+    internal::OutputBuffer outputBuffer;
+    std::ostream bufferedOutput;
 
 public:
     // Disable copy construction and assignment.
@@ -82,7 +163,10 @@ public:
 public:
     Engine () :
         osPtr (&std::cout),
-        isPtr (&std::cin)
+        isPtr (&std::cin),
+        ringPtr (nullptr),
+        outputBuffer (std::cout),
+        bufferedOutput (&outputBuffer)
     {
         if (::RenAllocEngine(&handle) != 0) {
             throw std::runtime_error ("Couldn't initialize red runtime");
@@ -130,6 +214,35 @@ public:
 
     std::istream & getInputStream();
 
+    // When there is an input ring (see input.hpp) the runtime reads from it
+    // instead of the input stream; pass nullptr to go back to the stream
+    InputRing * setInputRing(InputRing * ring) {
+        auto temp = ringPtr;
+        ringPtr = ring;
+        return temp;
+    }
+
+    InputRing * getInputRing() {
+        return ringPtr;
+    }
+
+    // Writes to the output stream through the buffer described above; this
+    // is what the runtime's output and ren::print use.  Text written to
+    // getOutputStream() directly can come out ahead of what's buffered.
+    std::ostream & getBufferedOutput() {
+        return bufferedOutput;
+    }
+
+    void setOutputPolicy(OutputPolicy const & policy);
+
+    OutputPolicy const & getOutputPolicy() const {
+        return outputBuffer.getPolicy();
+    }
+
+    void flushOutput() {
+        outputBuffer.flush();
+    }
+
     //
     // See notes on how close() is used for catching exceptions, while the
     // destructor should not throw:
@@ -147,6 +260,7 @@ public:
 
 
     virtual ~Engine() {
+        outputBuffer.flush();
         if (not REN_IS_ENGINE_HANDLE_INVALID(handle))
             ::RenFreeEngine(handle);
     }
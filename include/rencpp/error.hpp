@@ -94,17 +94,19 @@ public:
 class load_error : public std::exception {
 private:
     Error errorValue;
-    std::string whatString;
+    internal::LazyWhat lazyWhat;
 
 public:
     load_error (Error const & error) :
-        errorValue (error),
-        whatString (to_string(errorValue))
+        errorValue (error)
     {
     }
 
     char const * what() const noexcept override {
-        return whatString.c_str();
+        return lazyWhat.get(
+            [this]() { return to_string(errorValue); },
+            "ren::load_error"
+        );
     }
 
     Error error() const noexcept {
@@ -118,17 +120,19 @@ public:
 class evaluation_error : public std::exception {
 private:
     Error errorValue;
-    std::string whatString;
+    internal::LazyWhat lazyWhat;
 
 public:
     evaluation_error (Error const & error) :
-        errorValue (error),
-        whatString (to_string(errorValue))
+        errorValue (error)
     {
     }
 
     char const * what() const noexcept override {
-        return whatString.c_str();
+        return lazyWhat.get(
+            [this]() { return to_string(errorValue); },
+            "ren::evaluation_error"
+        );
     }
 
     Error error() const noexcept {
@@ -171,6 +175,51 @@ public:
 };
 
 
+//
+// BUDGET EXCEEDED EXCEPTION
+//
+
+//
+// An evaluation given a ren::Budget (see runtime.hpp) is halted if it runs
+// past any of the limits, and this is thrown instead of evaluation_halt.
+// It is derived from evaluation_halt so code that handles halting in
+// general handles this too.
+//
+
+enum class BudgetLimit {
+    Deadline,
+    EvalSteps,
+    MemoryBytes
+};
+
+class budget_exceeded : public evaluation_halt {
+private:
+    BudgetLimit limitValue;
+
+public:
+    budget_exceeded (BudgetLimit limit) :
+        limitValue (limit)
+    {
+    }
+
+    char const * what() const noexcept override {
+        switch (limitValue) {
+        case BudgetLimit::Deadline:
+            return "ren::budget_exceeded (deadline)";
+        case BudgetLimit::EvalSteps:
+            return "ren::budget_exceeded (evaluation steps)";
+        case BudgetLimit::MemoryBytes:
+            return "ren::budget_exceeded (memory)";
+        default:
+            return "ren::budget_exceeded";
+        }
+    }
+
+    BudgetLimit limit() const noexcept {
+        return limitValue;
+    }
+};
+
 }
 
 #endif
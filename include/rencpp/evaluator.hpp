@@ -0,0 +1,179 @@
+#ifndef RENCPP_EVALUATOR_HPP
+#define RENCPP_EVALUATOR_HPP
+
+//
+// evaluator.hpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "value.hpp"
+#include "arrays.hpp"
+
+
+namespace ren {
+
+#ifdef REN_RUNTIME
+
+//
+// EVALUATOR SERVICE
+//
+
+//
+// The runtime can only be used by one thread at a time, so a program that
+// wants to evaluate from several has to funnel the work to one of them.
+// (Ren Garden's EvaluatorWorker does this with Qt signals and slots.)  An
+// Evaluator owns a thread that does all the evaluating, and can be handed
+// work from any thread:
+//
+//     ren::Evaluator evaluator;
+//
+//     auto sum = evaluator.submit("1 + 2");
+//     ... // do other things
+//     std::cout << *sum.get();
+//
+//     auto length = evaluator.post([]() {
+//         return Block {"a b c"}.length();
+//     });
+//
+// Submitting doesn't take a lock; jobs are pushed onto a list that the
+// evaluator's thread takes all at once, running whatever has built up as a
+// batch (in the order submitted).  Exceptions thrown by a job, such as an
+// evaluation_error, come out of the future's get().  Their what() molds
+// values, so asking for it on another thread has it made by the evaluator
+// as a job of its own, which that thread waits for (see LazyWhat).
+//
+// Values that come back from the evaluator are kept alive safely, but
+// doing anything with them (including destroying them) calls into the
+// runtime.  So once there is an Evaluator, the other threads should do
+// their work with values through post(), or while the evaluator is known
+// to be idle--and should not call ren::runtime directly.  A job must not
+// wait on the future of another job, as they run on the same thread.
+//
+// While a native that returned a std::future is waiting on it, jobs queued
+// behind are run in the meantime (see awaitFuture in function.hpp), still
+// in the order submitted: the oldest job not yet started goes first, even
+// if it was taken in the same batch as the waiting one.  Those are run
+// nested inside the waiting call, and only up to a few deep; a job that
+// waits deeper than that just waits.
+//
+// There can only be one Evaluator at a time.  Destroying it runs the jobs
+// already submitted before the thread is stopped.
+//
+
+class Evaluator {
+private:
+    struct Job {
+        Job * next;
+
+        virtual void run() = 0;
+
+        virtual ~Job () {
+        }
+    };
+
+    template <class R>
+    struct Task : public Job {
+        std::packaged_task<R()> task;
+
+        template <class F>
+        explicit Task (F && f) :
+            task (std::forward<F>(f))
+        {
+        }
+
+        void run() override {
+            task();
+        }
+    };
+
+    // Pushed onto by submitters, most recent first
+    std::atomic<Job *> incoming;
+
+    // Taken from incoming and not yet started, oldest first, and how deep
+    // in waiting jobs the one running is.  Only the evaluator's thread
+    // touches these.
+    Job * queued;
+    int nesting;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeup;
+    bool stopping;
+
+    std::function<void()> const drainNested;
+
+    // Where exceptions made by jobs have their what() made
+    std::shared_ptr<internal::WhatHome> const home;
+
+    std::thread thread;
+
+private:
+    void push(Job * job);
+    bool runNext();
+    void drain();
+    void serve();
+
+public:
+    Evaluator ();
+
+    Evaluator (Evaluator const &) = delete;
+    Evaluator & operator= (Evaluator const &) = delete;
+
+    // Runs the source text, as ren::runtime(source) would
+    std::future<optional<AnyValue>> submit(std::string source);
+
+    // Runs code already loaded, as ren::runtime("do", code) would.  Copying
+    // the block calls into the runtime, so like any value it may only be
+    // passed from a job, or while the evaluator is idle.
+    std::future<optional<AnyValue>> submit(Block code);
+
+    // Runs any callable on the evaluator's thread
+    template <class F>
+    auto post(F && f)
+        -> std::future<typename std::result_of<
+            typename std::decay<F>::type()
+        >::type>
+    {
+        using R = typename std::result_of<typename std::decay<F>::type()>::type;
+
+        auto task = new Task<R> (std::forward<F>(f));
+        auto future = task->task.get_future();
+        push(task);
+        return future;
+    }
+
+    bool isEvaluatorThread() const noexcept {
+        return std::this_thread::get_id() == thread.get_id();
+    }
+
+    ~Evaluator ();
+};
+
+#endif
+
+} // end namespace ren
+
+#endif
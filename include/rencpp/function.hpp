@@ -19,9 +19,17 @@
 // See http://rencpp.hostilefork.com for more information on this project
 //
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <future>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -53,36 +61,189 @@ namespace internal {
 // functions *don't even know their own pointer*!
 //
 // So what we do here is a trick.  The first call to the function isn't asking
-// it to forward parameters, it's just asking it to save knowledge of its own
-// identity and the pointer to the function it should forward to in future
-// calls.  Because the macro is instantiated by each client, there is a
-// unique pointer for each lambda.  It's really probably the only way this
-// can be done without changing the runtime to pass something more to us.
+// it to forward parameters, it's just asking it to hand over the addresses
+// of the statics where it keeps its identity and the pointer to the
+// function it should forward to in future calls.  The generator fills those
+// in (and may clear the identity again if the function is released).
+// Because the macro is instantiated by each client, there is a unique
+// pointer for each lambda.  It's really probably the only way this can be
+// done without changing the runtime to pass something more to us.
 //
-// It should be noted that if you try to re-use a lambda to make a function
-// value twice this way, you will be getting another spec block.  It is
-// technically possible to get multiple function values for the same lambda
-// with different specs (though this is probably not what you want; you
-// should probably find a way to create functions only once).
+// It should be noted that a use of the macro has only one identity, and so
+// one table slot.  If you make a function value with it again while the
+// slot is still registered, you get another spec block for the *same*
+// C++ callable as the first time (any new one passed in is not used).  Once
+// every registration has been released with Function::release(), the next
+// construction from that spot starts over with a fresh callable.
 //
 
 #define REN_STD_FUNCTION \
     [](RenCall * call) -> RenResult {\
-        static ren::internal::RenShimId id = -1; \
-        static ren::internal::RenShimBouncer bouncer = nullptr; \
+        static std::atomic<ren::internal::RenShimId> id {-1}; \
+        static std::atomic<ren::internal::RenShimBouncer> bouncer {nullptr}; \
         if (call) \
-            return bouncer(id, call); \
-        if (id != -1) \
-            return REN_SHIM_INITIALIZED; \
-        id = ren::internal::shimIdToCapture; \
-        bouncer = ren::internal::shimBouncerToCapture; \
+            return bouncer.load(std::memory_order_acquire)( \
+                id.load(std::memory_order_acquire), call \
+            ); \
+        ren::internal::shimIdToCapture = &id; \
+        ren::internal::shimBouncerToCapture = &bouncer; \
         return REN_SHIM_INITIALIZED; \
     }
 
+
+
+
+//
+// SPEC BLOCK ARITY
+//
+
+//
+// The shim reads arguments out of the call frame by position, trusting that
+// the C++ signature lines up with what the spec block asks the runtime to
+// gather.  When the spec is a string literal this can be checked while
+// compiling, by counting the tokens at the top level of the spec that take
+// a slot in the frame.  Those are the words (plain, lit, and get) and the
+// refinements; doc strings, comments, and type blocks do not.  As it is a
+// recursive C++11 constexpr, very long specs may run into the compiler's
+// constexpr depth limit.
+//
+//     auto add = [](Integer const & a, Integer const & b) { return a + b; };
+//     REN_CHECK_FUNCTION_ARITY("a [integer!] b [integer!]", add);
+//
+// Whether or not that was used, constructing the function counts the loaded
+// spec block by the same rule and throws std::invalid_argument if it doesn't
+// match, so a mismatch can't get as far as a call.
+//
+
+constexpr bool isSpecSpace(char c) {
+    return c == ' ' or c == '\t' or c == '\r' or c == '\n';
+}
+
+constexpr bool isSpecDelimiter(char c) {
+    return c == '\0' or isSpecSpace(c)
+        or c == '[' or c == ']' or c == '{' or c == '}'
+        or c == '"' or c == ';';
+}
+
+constexpr char const * skipSpecToken(char const * s) {
+    return isSpecDelimiter(*s) ? s : skipSpecToken(s + 1);
+}
+
+constexpr char const * skipSpecLine(char const * s) {
+    return (*s == '\0' or *s == '\n') ? s : skipSpecLine(s + 1);
+}
+
+constexpr char const * skipSpecQuoted(char const * s) {
+    return *s == '\0' ? throw std::logic_error("Unterminated spec string")
+        : *s == '^' ? skipSpecQuoted(s + 2)
+        : *s == '"' ? s + 1
+        : skipSpecQuoted(s + 1);
+}
+
+constexpr char const * skipSpecBraced(char const * s, int depth) {
+    return *s == '\0' ? throw std::logic_error("Unterminated spec string")
+        : *s == '^' ? skipSpecBraced(s + 2, depth)
+        : *s == '{' ? skipSpecBraced(s + 1, depth + 1)
+        : *s == '}' ? (depth == 1 ? s + 1 : skipSpecBraced(s + 1, depth - 1))
+        : skipSpecBraced(s + 1, depth);
+}
+
+constexpr char const * skipSpecBlock(char const * s, int depth) {
+    return *s == '\0' ? throw std::logic_error("Unterminated spec block")
+        : *s == '{' ? skipSpecBlock(skipSpecBraced(s + 1, 1), depth)
+        : *s == '"' ? skipSpecBlock(skipSpecQuoted(s + 1), depth)
+        : *s == ';' ? skipSpecBlock(skipSpecLine(s), depth)
+        : *s == '[' ? skipSpecBlock(s + 1, depth + 1)
+        : *s == ']' ? (depth == 1 ? s + 1 : skipSpecBlock(s + 1, depth - 1))
+        : skipSpecBlock(s + 1, depth);
+}
+
+constexpr std::size_t specArity(char const * s, std::size_t count = 0) {
+    return *s == '\0' ? count
+        : isSpecSpace(*s) ? specArity(s + 1, count)
+        : *s == '[' ? specArity(skipSpecBlock(s + 1, 1), count)
+        : *s == '{' ? specArity(skipSpecBraced(s + 1, 1), count)
+        : *s == '"' ? specArity(skipSpecQuoted(s + 1), count)
+        : *s == ';' ? specArity(skipSpecLine(s), count)
+        : (*s == ']' or *s == '}')
+            ? throw std::logic_error("Unbalanced spec block")
+        : specArity(skipSpecToken(s), count + 1);
+}
+
+#define REN_CHECK_FUNCTION_ARITY(spec, fun) \
+    static_assert( \
+        ::ren::internal::specArity(spec) \
+            == ::ren::utility::function_traits<decltype(fun)>::arity, \
+        "ren::Function spec block arity doesn't match the C++ signature" \
+    )
+
+void checkSpecArity(Block const & spec, std::size_t arity);
+
+
+
+//
+// STATIC FUNCTION ADAPTER
+//
+
+//
+// Wraps a function pointer known at compile time as a callable with no
+// state, so plain functions can use the direct construction path below.
+//
+
+template <class F, F f>
+struct StaticFunction;
+
+template <class R, class... Args, R (*f)(Args...)>
+struct StaticFunction<R (*)(Args...), f> {
+    R operator()(Args... args) const {
+        return f(std::forward<Args>(args)...);
+    }
+};
+
 } // end namespace internal
 
 
 
+//
+// BORROWED ARGUMENTS
+//
+
+//
+// The arguments to a native are protected from garbage collection by the
+// call frame for as long as the native runs.  So there's no need to put the
+// C++ objects made for them into the tracking list (which means taking a
+// lock) just to have them taken out again when the call returns.  Natives
+// therefore get their arguments "borrowed" by default, whatever parameter
+// type they are declared with, and a copy or move is what promotes one to a
+// fully tracked value.  Anything which has to outlive the call--a member,
+// a capture, a container element--will have been copied, so that's safe.
+//
+// Arg<T> spells this out in a signature, and ArgRef<T> is the reference
+// form.  They may be used like the T they derive from; copying one gives
+// an ordinary tracked value.
+//
+//     [](ArgRef<Block> blk) -> Integer { return blk.length(); }
+//
+// (optional<T> parameters are still tracked, as the optional would copy.)
+//
+
+template <class T>
+class Arg : public T {
+    static_assert(
+        std::is_base_of<AnyValue, T>::value,
+        "ren::Arg<T> is only for ren:: value classes"
+    );
+
+protected:
+    friend class AnyValue;
+    Arg (AnyValue::Dont) : T (AnyValue::Dont::Initialize) {}
+};
+
+template <class T>
+using ArgRef = Arg<T> const &;
+
+
+
 //
 // FUNCTION TYPE(S?)
 //
@@ -123,6 +284,27 @@ private:
         RenShimPointer const & shim
     );
 
+    // The C function pointer of a native, or nullptr if not a native
+    RenShimPointer getShim() const;
+
+public:
+    //
+    // Natives made with REN_STD_FUNCTION keep their C++ callable (and
+    // anything it captured) in a table slot.  There's no hook for knowing
+    // when the runtime's garbage collector frees a native, so the slot is
+    // released explicitly: call release() once for each construct() when
+    // the function is no longer needed.  After the last release the
+    // callable is destroyed and the slot is reused; calling the function
+    // from the runtime after that raises an error.  It must not be called
+    // while the function is running.
+    //
+    // Returns true if that was the last registration.  Natives constructed
+    // without a REN_STD_FUNCTION shim have nothing to release.
+    //
+    bool release();
+
+private:
+
 
     //
     // The FunctionGenerator is an internal class.  One reason why the
@@ -307,6 +489,113 @@ public:
         );
     }
 
+    //
+    // Direct construction.  If the callable has no state--a lambda without
+    // captures, or a plain function given as a template argument--then no
+    // REN_STD_FUNCTION shim or std::function is needed.  The native calls
+    // it directly through a shim generated for its type.
+    //
+    //     auto add = Function::construct(
+    //         "a [integer!] b [integer!]",
+    //         [](Integer const & a, Integer const & b) { return a + b; }
+    //     );
+    //
+    //     Integer addInts(Integer const & a, Integer const & b);
+    //     auto add = Function::construct<decltype(&addInts), &addInts>(
+    //         "a [integer!] b [integer!]"
+    //     );
+    //
+
+    template<typename Fun, std::size_t... Ind>
+    static Function constructDirect_(
+        RenEngineHandle engine,
+        Block const & spec,
+        Fun const & fun,
+        utility::indices<Ind...>
+    ) {
+        using Ret = typename std::conditional<
+            std::is_void<utility::result_type<Fun>>::value,
+            optional<AnyValue>,
+            utility::result_type<Fun>
+        >::type;
+
+        using Gen = internal::FunctionGenerator<
+            Ret,
+            utility::argument_type<Fun, Ind>...
+        >;
+
+        return Gen::constructDirect(engine, spec, fun);
+    }
+
+    template<typename Fun>
+    static Function constructDirect_(
+        RenEngineHandle engine,
+        Block const & spec,
+        Fun && fun
+    ) {
+        using Callable = typename std::decay<Fun>::type;
+
+        using Indices = utility::make_indices<
+            utility::function_traits<Callable>::arity
+        >;
+
+        return constructDirect_(
+            engine,
+            spec,
+            static_cast<Callable const &>(fun),
+            Indices{}
+        );
+    }
+
+    template<typename Fun>
+    static Function construct(char const * spec, Fun && fun) {
+        return constructDirect_(
+            Engine::runFinder().getHandle(),
+            Block {spec},
+            std::forward<Fun>(fun)
+        );
+    }
+
+    template<typename Fun>
+    static Function construct(Block const & spec, Fun && fun) {
+        return constructDirect_(
+            Engine::runFinder().getHandle(),
+            spec,
+            std::forward<Fun>(fun)
+        );
+    }
+
+    template<typename Fun>
+    static Function construct(Engine & engine, char const * spec, Fun && fun) {
+        return constructDirect_(
+            engine.getHandle(),
+            Block {spec},
+            std::forward<Fun>(fun)
+        );
+    }
+
+    template<typename Fun>
+    static Function construct(
+        Engine & engine, Block const & spec, Fun && fun
+    ) {
+        return constructDirect_(
+            engine.getHandle(),
+            spec,
+            std::forward<Fun>(fun)
+        );
+    }
+
+    template<typename F, F f>
+    static Function construct(char const * spec) {
+        return construct(spec, internal::StaticFunction<F, f> {});
+    }
+
+    template<typename F, F f>
+    static Function construct(Engine & engine, char const * spec) {
+        return construct(engine, spec, internal::StaticFunction<F, f> {});
+    }
+
+
     // This apply convenience overload used to be available to all values,
     // but it really only makes sense for a few value types.
 public:
@@ -356,18 +645,316 @@ namespace internal {
 //
 // Limits of the type system and specialization force us to have a table
 // of functions on a per-template specialization basis.  However, there's
-// no good reason to have one mutex per table.  One for all will do.
+// no good reason to have one mutex per table.  One for all will do.  It is
+// only taken when functions are being added, not when they are called.
 //
 
 extern std::mutex extensionTablesMutex;
 
+
+
+//
+// SHIM TABLE
+//
+
+//
+// Every call of a native goes through its table entry, so that lookup needs
+// to be cheap and must not serialize threads that are running natives.  A
+// std::vector can't be read while another thread might be growing it, so
+// the table is instead an append-only series of chunks which never move
+// once allocated.  Chunk k holds (FirstChunkSize << k) entries, so a small
+// fixed array of chunk pointers is enough for any realistic count.
+//
+// Writers must hold extensionTablesMutex.  An entry is fully constructed
+// before the count is published with a release store, so a reader that
+// acquires the count can use the entry without locking.  Entries keep
+// their address until the program exits and are handed out by reference;
+// the generator may recycle one for a new registration (see release()).
+//
+
+template <class Entry>
+class ShimTable {
+private:
+    static constexpr size_t FirstChunkSize = 32;
+    static constexpr size_t MaxChunks = 26;
+
+    using Slot = typename std::aligned_storage<
+        sizeof(Entry), alignof(Entry)
+    >::type;
+
+    std::atomic<Slot *> chunks[MaxChunks];
+    std::atomic<size_t> count;
+
+    static size_t chunkStart(size_t chunk) {
+        return FirstChunkSize * ((size_t {1} << chunk) - 1);
+    }
+
+    static size_t chunkOf(size_t index) {
+        size_t chunk = 0;
+        while (index >= chunkStart(chunk + 1))
+            ++chunk;
+        return chunk;
+    }
+
+    Slot * slotFor(size_t index) const {
+        size_t chunk = chunkOf(index);
+        return chunks[chunk].load(std::memory_order_acquire)
+            + (index - chunkStart(chunk));
+    }
+
+public:
+    ShimTable () : count (0) {
+        for (auto & chunk : chunks)
+            chunk.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ShimTable (ShimTable const &) = delete;
+    ShimTable & operator= (ShimTable const &) = delete;
+
+    ~ShimTable () {
+        size_t n = count.load(std::memory_order_acquire);
+        for (size_t index = 0; index < n; ++index)
+            reinterpret_cast<Entry *>(slotFor(index))->~Entry();
+        for (auto & chunk : chunks)
+            delete [] chunk.load(std::memory_order_relaxed);
+    }
+
+    size_t size() const {
+        return count.load(std::memory_order_acquire);
+    }
+
+    // Caller must hold extensionTablesMutex
+    template <class... Args>
+    size_t emplace(Args &&... args) {
+        size_t index = count.load(std::memory_order_relaxed);
+        size_t chunk = chunkOf(index);
+        if (chunk >= MaxChunks)
+            throw std::runtime_error("Too many ren::Function shims");
+
+        if (not chunks[chunk].load(std::memory_order_relaxed))
+            chunks[chunk].store(
+                new Slot[FirstChunkSize << chunk], std::memory_order_release
+            );
+
+        new (slotFor(index)) Entry (std::forward<Args>(args)...);
+        count.store(index + 1, std::memory_order_release);
+        return index;
+    }
+
+    Entry const & operator[](size_t index) const {
+        assert(index < size());
+        return *reinterpret_cast<Entry const *>(slotFor(index));
+    }
+
+    // For reusing a released slot; caller must hold extensionTablesMutex
+    Entry & mutableAt(size_t index) {
+        assert(index < size());
+        return *reinterpret_cast<Entry *>(slotFor(index));
+    }
+};
+
 using RenShimId = int;
 
-extern RenShimId shimIdToCapture;
+extern std::atomic<RenShimId> * shimIdToCapture;
 
 using RenShimBouncer = RenResult (*)(RenShimId id, RenCall * call);
 
-extern RenShimBouncer shimBouncerToCapture;
+extern std::atomic<RenShimBouncer> * shimBouncerToCapture;
+
+
+// Each REN_STD_FUNCTION shim that currently holds a table slot is noted
+// here, so that Function::release() can find its way back to the slot from
+// nothing but the function value.  The release hook returns true when the
+// last registration is dropped.  Caller must hold extensionTablesMutex.
+
+using RenShimReleaser = bool (*)(RenShimId id);
+
+void noteShimRegistration(
+    RenShimPointer shim, RenShimReleaser releaser, RenShimId id
+);
+
+
+
+//
+// CELL CODECS
+//
+
+//
+// Natives don't have to be written only in terms of ren:: value classes.
+// Parameters and results may also be plain C++ types, which are read from
+// and written to the call frame's cells directly--without constructing a
+// wrapper value, registering it, or (for strings) going through the
+// scanner:
+//
+//     [](int64_t a, double b) -> double { return a * b; }
+//
+// The spec block's typesets are what make this safe: if it says [integer!]
+// then the runtime has checked the type before the native is called.  A
+// cell of the wrong type (say, a spec of [number!] with an int64_t
+// parameter) raises a ren::Error in the runtime.
+//
+// The primary template covers the ren:: value classes and optional<> of
+// them.  The specializations for C++ types are implemented by each binding.
+//
+
+template <class T, class Enable>
+struct CellCodec {
+    static T fromCell(RenCell const & cell, RenEngineHandle engine) {
+        return AnyValue::fromCell_<T>(cell, engine);
+    }
+
+    static void toCell(RenCell & cell, T const & value, RenEngineHandle) {
+        AnyValue::toCell_(cell, value);
+    }
+};
+
+template <>
+struct CellCodec<int64_t> {
+    static int64_t fromCell(RenCell const & cell, RenEngineHandle engine);
+    static void toCell(RenCell & cell, int64_t value, RenEngineHandle engine);
+};
+
+template <>
+struct CellCodec<int> {
+    static int fromCell(RenCell const & cell, RenEngineHandle engine);
+    static void toCell(RenCell & cell, int value, RenEngineHandle engine);
+};
+
+template <>
+struct CellCodec<double> {
+    static double fromCell(RenCell const & cell, RenEngineHandle engine);
+    static void toCell(RenCell & cell, double value, RenEngineHandle engine);
+};
+
+template <>
+struct CellCodec<bool> {
+    static bool fromCell(RenCell const & cell, RenEngineHandle engine);
+    static void toCell(RenCell & cell, bool value, RenEngineHandle engine);
+};
+
+template <>
+struct CellCodec<std::string> {
+    static std::string fromCell(RenCell const & cell, RenEngineHandle engine);
+
+    static void toCell(
+        RenCell & cell, std::string const & value, RenEngineHandle engine
+    );
+};
+
+
+// Minimal block access for the std::vector codec, implemented by each
+// binding.  The cell read from must be an ANY-ARRAY!; the items are taken
+// from its index position to its tail.
+
+void initBlockCell(RenCell & cell, size_t capacity);
+
+void appendToBlockCell(RenCell & block, RenCell const & item);
+
+size_t blockCellLength(RenCell const & block);
+
+RenCell const & blockCellAt(RenCell const & block, size_t index);
+
+
+template <class T>
+struct CellCodec<std::vector<T>> {
+    static std::vector<T> fromCell(
+        RenCell const & cell, RenEngineHandle engine
+    ) {
+        size_t length = blockCellLength(cell);
+
+        std::vector<T> result;
+        result.reserve(length);
+        for (size_t index = 0; index < length; ++index)
+            result.push_back(
+                CellCodec<T>::fromCell(blockCellAt(cell, index), engine)
+            );
+        return result;
+    }
+
+    static void toCell(
+        RenCell & cell, std::vector<T> const & value, RenEngineHandle engine
+    ) {
+        initBlockCell(cell, value.size());
+
+        RenCell item;
+        for (auto const & element : value) {
+            CellCodec<T>::toCell(item, element, engine);
+            appendToBlockCell(cell, item);
+        }
+    }
+};
+
+
+//
+// A native may also hand back a std::future, for work it has passed off to
+// another thread (or a std::async).  This is NOT an asynchronous native:
+// the script is not suspended, and the evaluating thread blocks in the
+// native's call until the result is in.  The runtimes keep an evaluation's
+// state on the C stack and in globals, so there is no way to set a script
+// aside mid-call and resume it later.
+//
+// What the wait does do is poll, in slices, for a halt requested with
+// Runtime::cancel(), so that a slow or stuck future doesn't make the
+// evaluation uninterruptible.  A future that is halted out of is handed to
+// a thread of its own, which waits for it, since destroying a std::async
+// future blocks until its task is done--it's that thread that waits, not
+// the halt.  An exception stored in the future is rethrown in the native,
+// and so is translated for the runtime like any other.
+//
+// Whoever owns the evaluating thread can also have other work done in the
+// slices, by pointing whileAwaitingFuture at it.  ren::Evaluator uses this
+// to run jobs that were queued behind the waiting one, nested inside its
+// call (so they finish before it does, not alongside it).
+//
+
+constexpr std::chrono::milliseconds futurePollInterval {10};
+
+extern thread_local std::function<void()> const * whileAwaitingFuture;
+
+template <class T>
+void abandonFuture(std::future<T> && future) {
+    std::thread {
+        [](std::future<T> abandoned) { abandoned.wait(); },
+        std::move(future)
+    }.detach();
+}
+
+template <class T>
+void awaitFuture(std::future<T> & future) {
+    // A deferred future has nothing to wait on; get() runs it here
+    while (
+        future.wait_for(futurePollInterval) == std::future_status::timeout
+    ) {
+        if (RenShimHaltRequested()) {
+            abandonFuture(std::move(future));
+            throw evaluation_halt {};
+        }
+
+        if (whileAwaitingFuture)
+            (*whileAwaitingFuture)();
+    }
+}
+
+template <class T>
+struct CellCodec<std::future<T>> {
+    static void toCell(
+        RenCell & cell, std::future<T> & value, RenEngineHandle engine
+    ) {
+        awaitFuture(value);
+        CellCodec<T>::toCell(cell, value.get(), engine);
+    }
+};
+
+template <>
+struct CellCodec<std::future<void>> {
+    static void toCell(
+        RenCell & cell, std::future<void> & value, RenEngineHandle
+    ) {
+        awaitFuture(value);
+        value.get();
+        AnyValue::toCell_(cell, optional<AnyValue> {});
+    }
+};
 
 
 
@@ -400,31 +987,85 @@ private:
     // looks in this per-signature table to find the std::function to
     // unpack the parameters and give to.  It also has the engine handle,
     // which is required to construct the values for the cells in the
-    // appropriate sandbox.  The vector is only added to and never removed,
-    // but it has to be protected with a mutex in case multiple threads
-    // are working with it at the same time.
+    // appropriate sandbox.  Entries don't move, so calls can find them
+    // without locking.
+    //
+    // A slot belongs to one shim (one use of REN_STD_FUNCTION) and counts
+    // the function values registered through it.  When the count drops to
+    // zero the slot lets go of the callable, the shim forgets its id, and
+    // the id goes on the free list to be reused by the next registration.
+    // Calls take their own reference to the callable (with the shared_ptr
+    // atomics), so one still running keeps it alive through a release and
+    // never sees it half replaced by a reuse.
+
+    struct Callable {
+        RenEngineHandle engine;
+        FunType fun;
+    };
 
     struct TableEntry {
-        RenEngineHandle engine;
-        FunType const fun;
+        std::shared_ptr<Callable const> callable; // null once released
+
+        std::atomic<RenShimId> * site; // the shim's own id static
+        unsigned int registrations; // guarded by extensionTablesMutex
+
+        TableEntry (
+            RenEngineHandle engine,
+            FunType const & fun,
+            std::atomic<RenShimId> * site
+        ) :
+            callable (std::make_shared<Callable const>(Callable {engine, fun})),
+            site (site),
+            registrations (1)
+        {
+        }
     };
 
-    static std::vector<TableEntry> table;
+    static ShimTable<TableEntry> table;
+
+    static std::vector<RenShimId> freeIds; // guarded by extensionTablesMutex
 
 
     // Function used to create Ts... on the fly and apply a
-    // given function to them
+    // given function to them.  The function is usually the std::function
+    // from the table, but may be the callable itself (see Direct below)
+
+    // Arguments that are value classes are borrowed from the call frame
+    // (see Arg<T>); anything else goes through its CellCodec
 
-    template <std::size_t... Indices>
+    template <class T>
+    static T argFromCell(
+        RenCell const & cell, RenEngineHandle engine,
+        std::true_type // value class
+    ) {
+        return AnyValue::borrowCell_<T>(cell, engine);
+    }
+
+    template <class T>
+    static T argFromCell(
+        RenCell const & cell, RenEngineHandle engine,
+        std::false_type // value class
+    ) {
+        return CellCodec<T>::fromCell(cell, engine);
+    }
+
+    template <class T>
+    static T argFromCell(RenCell const & cell, RenEngineHandle engine) {
+        return argFromCell<T>(
+            cell, engine, typename std::is_base_of<AnyValue, T>::type{}
+        );
+    }
+
+    template <class F, std::size_t... Indices>
     static auto applyFunImpl(
-        FunType const & fun,
+        F const & fun,
         RenEngineHandle engine,
         RenCall * call,
         utility::indices<Indices...>
     )
         -> decltype(
             fun(
-				AnyValue::fromCell_<
+				argFromCell<
                     typename std::decay<
                         typename utility::type_at<Indices, Ts...>::type
                     >::type
@@ -436,39 +1077,110 @@ private:
         )
     {
         return fun(
-			AnyValue::fromCell_<
+			argFromCell<
                 typename std::decay<
                     typename utility::type_at<Indices, Ts...>::type
                 >::type
             >(
-                *REN_CS_ARG(call, static_cast<REBINT>(Indices)),
+                *REN_CS_ARG(call, static_cast<int>(Indices)),
                 engine
             )...
         );
     }
 
-    template <typename Indices = utility::make_indices<sizeof...(Ts)>>
+    template <
+        class F,
+        typename Indices = utility::make_indices<sizeof...(Ts)>
+    >
     static auto applyFun(
-        FunType const & fun, RenEngineHandle engine, RenCall * call
+        F const & fun, RenEngineHandle engine, RenCall * call
     ) ->
         decltype(applyFunImpl(fun, engine, call, Indices {}))
     {
         return applyFunImpl(fun, engine, call, Indices {});
     }
 
+
+    // The return result is written into a location that is known according
+    // to the protocol of the call frame.  A callable returning void gives
+    // back no value, which is the disengaged state of optional<AnyValue>
+
+    template <class F>
+    static void applyFunInto(
+        F const & fun, RenEngineHandle engine, RenCall * call,
+        std::false_type // returns void
+    ) {
+        auto && out = applyFun(fun, engine, call);
+
+        using Out = typename std::decay<decltype(out)>::type;
+        CellCodec<Out>::toCell(*REN_CS_OUT(call), out, engine);
+    }
+
+    template <class F>
+    static void applyFunInto(
+        F const & fun, RenEngineHandle engine, RenCall * call,
+        std::true_type // returns void
+    ) {
+        applyFun(fun, engine, call);
+        AnyValue::toCell_(*REN_CS_OUT(call), optional<AnyValue> {});
+    }
+
+    template <class F>
+    static void applyFunInto(
+        F const & fun, RenEngineHandle engine, RenCall * call
+    ) {
+        using Result = decltype(applyFun(fun, engine, call));
+        applyFunInto(fun, engine, call, typename std::is_void<Result>::type{});
+    }
+
 private:
     static RenResult bounceShim(internal::RenShimId id, RenCall * call) {
-        using internal::extensionTablesMutex;
+        // A function value can outlive its registration in the runtime, so
+        // it may call in after release() (with the shim's id cleared).
+        // The reference taken here is what keeps the callable alive if it
+        // is released while the call runs.
+
+        std::shared_ptr<Callable const> callable;
+        if (id >= 0) {
+            TableEntry const & entry = table[static_cast<size_t>(id)];
+            callable = std::atomic_load(&entry.callable);
+        }
+
+        if (not callable) {
+            return runShim(call, []() {
+                throw Error {"Called a ren::Function that has been released"};
+            });
+        }
 
-        // The extension table is add-only, but additions can resize,
-        // and move the underlying memory.  We either hold the lock for
-        // the entire duration of the function run, or copy the table
-        // entry out by value... the latter makes more sense.
+        return runShim(call, [&callable, call]() {
+            applyFunInto(callable->fun, callable->engine, call);
+        });
+    }
+
+
+    // Caller must hold extensionTablesMutex.  A call still running in the
+    // callable has its own reference, so it is destroyed when that ends.
+
+    static bool releaseSlot(RenShimId id) {
+        TableEntry & entry = table.mutableAt(static_cast<size_t>(id));
+        assert(entry.registrations > 0);
+
+        if (--entry.registrations != 0)
+            return false;
 
-        extensionTablesMutex.lock();
-        TableEntry entry = table[static_cast<size_t>(id)];
-        extensionTablesMutex.unlock();
+        entry.site->store(-1, std::memory_order_release);
+        std::atomic_store(&entry.callable, std::shared_ptr<Callable const> {});
+        freeIds.push_back(id);
+        return true;
+    }
+
+
+    // Runs the body of a native, which writes its result to the call frame,
+    // and translates what it throws into what the runtime expects.  This
+    // is shared by the table-driven shims and the direct ones.
 
+    template <class Body>
+    static RenResult runShim(RenCall * call, Body const & body) {
         // To be idiomatic for C++, we want to be able to throw a ren::Error
         // using C++ exceptions from within a ren::Function.  Yet since the
         // ren runtimes cannot catch C++ exceptions, we have to translate it
@@ -488,12 +1200,7 @@ private:
             // (who is blissfully unaware of the call frame convention and
             // writing using high-level types...)
 
-			auto && out = applyFun(entry.fun, entry.engine, call);
-
-            // The return result is written into a location that is known
-            // according to the protocol of the call frame
-
-			AnyValue::toCell_(*REN_CS_OUT(call), out); // out may be optional
+			body();
 			result = REN_SUCCESS;
         }
         catch (bad_optional_access const & e) {
@@ -622,6 +1329,65 @@ private:
 		}
     }
 
+    //
+    // A callable with no state has nothing which needs to be looked up when
+    // it is called, so it doesn't need a table entry or a self-aware shim.
+    // Each such callable type gets a shim of its own, which calls it
+    // directly (and can be inlined along with the argument marshaling)
+    // instead of going through a std::function.
+    //
+    // One copy is kept per type; since the type is empty, any copy will do.
+    // The copy and the engine are set under extensionTablesMutex before the
+    // native is made, and never change after that.
+    //
+
+    template <class Fun>
+    struct Direct {
+        static optional<Fun> instance;
+        static RenEngineHandle engine;
+
+        static RenResult shim(RenCall * call) {
+            return runShim(call, [call]() {
+                applyFunInto(*instance, engine, call);
+            });
+        }
+    };
+
+    FunctionGenerator (Dont) : Function (Dont::Initialize) {}
+
+public:
+    template <class Fun>
+    static Function constructDirect(
+        RenEngineHandle engine,
+        Block const & spec,
+        Fun const & fun
+    ) {
+        static_assert(
+            std::is_empty<Fun>::value,
+            "Direct ren::Function construction needs a callable with no"
+            " state (e.g. a lambda without captures); use REN_STD_FUNCTION"
+        );
+
+        internal::checkSpecArity(spec, sizeof...(Ts));
+
+        {
+            std::lock_guard<std::mutex> lock {internal::extensionTablesMutex};
+
+            if (Direct<Fun>::instance == nullopt) {
+                Direct<Fun>::instance.emplace(fun);
+                Direct<Fun>::engine = engine;
+            }
+            else if (Direct<Fun>::engine.data != engine.data)
+                throw std::runtime_error(
+                    "Direct ren::Function already made in another engine"
+                );
+        }
+
+        FunctionGenerator result (Dont::Initialize);
+        result.finishInitSpecial(engine, spec, &Direct<Fun>::shim);
+        return result;
+    }
+
 public:
     FunctionGenerator (
         RenEngineHandle engine,
@@ -631,32 +1397,66 @@ public:
     ) :
         Function (Dont::Initialize)
     {
+        internal::checkSpecArity(spec, sizeof...(Ts));
+
         // First we lock the global table so we can call the shim for the
-        // initial time.  It will grab its identity so that from then on it
-        // can forward calls to us.
+        // initial time.  It will tell us where it keeps its identity so that
+        // we can give it a slot, and from then on it can forward calls to us.
 
         std::lock_guard<std::mutex> lock {internal::extensionTablesMutex};
 
-        assert(::ren::internal::shimIdToCapture == -1);
+        assert(not ::ren::internal::shimIdToCapture);
         assert(not ::ren::internal::shimBouncerToCapture);
 
-        ::ren::internal::shimIdToCapture = static_cast<int>(table.size());
-        ::ren::internal::shimBouncerToCapture = &bounceShim;
-
         if (shim(nullptr) != REN_SHIM_INITIALIZED)
             throw std::runtime_error(
                 "First shim call didn't return REN_SHIM_INITIALIZED"
             );
 
-        ::ren::internal::shimIdToCapture = -1;
+        std::atomic<RenShimId> * site = ::ren::internal::shimIdToCapture;
+        std::atomic<RenShimBouncer> * bouncer =
+            ::ren::internal::shimBouncerToCapture;
+
+        ::ren::internal::shimIdToCapture = nullptr;
         ::ren::internal::shimBouncerToCapture = nullptr;
 
-        // Insert the shim into the mapping table so it can find itself while
-        // the shim code is running.  Note that the tableAdd code has
-        // to be thread-safe in case two threads try to modify the global
-        // table at the same time.
+        if (not site or not bouncer)
+            throw std::runtime_error(
+                "Shim for ren::Function must come from REN_STD_FUNCTION"
+            );
+
+        RenShimId id = site->load(std::memory_order_relaxed);
+
+        if (id != -1) {
+            // This shim already has a live slot; count another registration
+            // against it.  (See notes on REN_STD_FUNCTION.)
+
+            ++table.mutableAt(static_cast<size_t>(id)).registrations;
+        }
+        else if (not freeIds.empty()) {
+            id = freeIds.back();
+            freeIds.pop_back();
+
+            TableEntry & entry = table.mutableAt(static_cast<size_t>(id));
+            entry.site = site;
+            entry.registrations = 1;
+            std::atomic_store(
+                &entry.callable,
+                std::make_shared<Callable const>(Callable {engine, fun})
+            );
+        }
+        else {
+            // The table's emplace() is only safe because we are still
+            // holding the lock, in case two threads add at the same time;
+            // the shims calling in later do not need it.
+
+            id = static_cast<RenShimId>(table.emplace(engine, fun, site));
+        }
 
-        table.push_back({engine, fun});
+        bouncer->store(&bounceShim, std::memory_order_release);
+        site->store(id, std::memory_order_release);
+
+        internal::noteShimRegistration(shim, &releaseSlot, id);
 
         // We've got what we need, but depending on the runtime it will have
         // a different encoding of the shim and type into the bits of the
@@ -674,10 +1474,22 @@ public:
 //
 
 template<class R, class... Ts>
-std::vector<
+ShimTable<
     typename FunctionGenerator<R, Ts...>::TableEntry
 > FunctionGenerator<R, Ts...>::table;
 
+template<class R, class... Ts>
+std::vector<RenShimId> FunctionGenerator<R, Ts...>::freeIds;
+
+template<class R, class... Ts>
+template<class Fun>
+optional<Fun> FunctionGenerator<R, Ts...>::Direct<Fun>::instance;
+
+template<class R, class... Ts>
+template<class Fun>
+RenEngineHandle FunctionGenerator<R, Ts...>::Direct<Fun>::engine
+    = REN_ENGINE_HANDLE_INVALID;
+
 
 } // end namespace internal
 
@@ -52,6 +52,9 @@ namespace ren {
 // question about coming up with something like that, so the Engine::runFinder
 // calls in here are pretty rough, but we'll see where that goes.
 //
+// Output goes through the engine's buffer, the same as the runtime's own
+// PRINT, so the two come out in order (see OutputPolicy in engine.hpp).
+//
 
 
 class Printer {
@@ -61,23 +64,24 @@ public:
     }
 
     template <typename T>
-    void writeArgs(bool , T && t) {
-        Engine::runFinder().getOutputStream() << std::forward<T>(t);
+    void writeArgs(std::ostream & os, bool , T && t) {
+        os << std::forward<T>(t);
     }
 
     template <typename T, typename... Ts>
-    void writeArgs(bool spaced, T && t, Ts &&... args) {
-        writeArgs(spaced, std::forward<T>(t));
+    void writeArgs(std::ostream & os, bool spaced, T && t, Ts &&... args) {
+        writeArgs(os, spaced, std::forward<T>(t));
         if (spaced)
-            Engine::runFinder().getOutputStream() << " ";
-        writeArgs(spaced, std::forward<Ts>(args)...);
+            os << ' ';
+        writeArgs(os, spaced, std::forward<Ts>(args)...);
     }
 
     template <typename... Ts>
     void corePrint(bool spaced, bool linefeed, Ts &&... args) {
-        writeArgs(spaced, std::forward<Ts>(args)...);
+        std::ostream & os = Engine::runFinder().getBufferedOutput();
+        writeArgs(os, spaced, std::forward<Ts>(args)...);
         if (linefeed)
-            Engine::runFinder().getOutputStream() << std::endl;
+            os << '\n';
     }
 
     template <typename... Ts>
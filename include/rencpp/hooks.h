@@ -60,6 +60,9 @@
 #define REN_SHIM_INITIALIZED 15
 #define REN_EVALUATION_HALTED 16
 #define REN_BAD_ENGINE_HANDLE 17
+#define REN_BUDGET_EXCEEDED 18
+#define REN_EVAL_STEPS_EXCEEDED 19
+#define REN_MEMORY_EXCEEDED 20
 
 
 /*
@@ -180,19 +183,25 @@ typedef RedEngineHandle RenEngineHandle;
  * The Red runtime is still fake for the moment, so no real convention for the
  * stack has been established.  But this lays out what is needed for the binding
  * to be able to process arguments, if the RenShimPointer function signature is
- * as written.
+ * as written: somewhere for the result, the arguments, and the shim.
  */
 
+struct RedCall {
+    RedCell * out;
+    RedCell * args;
+    RenResult (* shim)(struct RedCall * call);
+};
+
+typedef struct RedCall RenCall;
+
 #define REN_CS_OUT(stack) \
-    static_cast<RenCell *>((stack), nullptr)
+    ((stack)->out)
 
 #define REN_CS_ARG(stack, index) \
-    static_cast<RenCell *>((stack), nullptr)
+    (&(stack)->args[(index)])
 
 #define REN_STACK_SHIM(stack) \
-    static_cast<RenShimPointer>((stack), nullptr)
-
-typedef void* RenCall; // TBD
+    ((stack)->shim)
 
 #elif (!defined(REN_RUNTIME)) || (REN_RUNTIME == REN_RUNTIME_REBOL)
 
@@ -291,6 +300,15 @@ typedef RenResult (* RenShimPointer)(RenCall * call);
 RenResult RenShimHalt();
 
 
+/*
+ * A shim which is blocked waiting on something (such as a std::future) asks
+ * this periodically whether the evaluator has been cancelled meanwhile.  If
+ * it returns nonzero then the request has been taken, and the shim should
+ * stop waiting and return RenShimHalt().
+ */
+int RenShimHaltRequested();
+
+
 /*
  * When a throw happens, it has two RenCells to work with...the thrown value
  * and a value representing a label.  They can't both fit into a single
@@ -381,4 +399,64 @@ RenResult RenFormAsUtf8(
     size_t * numBytesOut
 );
 
+
+/*
+ * Loads UTF-8 source of a given length into a block, bound into the context
+ * (if one is given) the way loadables given to RenConstructOrApply are.
+ * If terminated is nonzero there is a NUL at utf8[size], and the text is
+ * scanned where it is; otherwise the binding may copy it to scan.  A syntax
+ * error gives REN_CONSTRUCT_ERROR, with the error in errorOut.
+ */
+
+RenResult RenLoadUtf8(
+    RenEngineHandle engine,
+    RenCell const * context,
+    unsigned char const * utf8,
+    size_t size,
+    int terminated,
+    RenCell * blockOut,
+    RenCell * errorOut
+);
+
+
+/*
+ * Step and memory budgets are enforced by the evaluator, on the thread that
+ * is evaluating.  RenLimitUsage() lets the evaluations that follow take no
+ * more than maxEvalSteps further steps and maxMemoryBytes further bytes of
+ * allocation (zero for no limit), on top of any limits already set; it gives
+ * back the limits it replaced, for RenRestoreUsageLimits() to put back when
+ * the budgeted evaluation is over.  Steps are tallied each time the evaluator
+ * stops to check for signals, so it may go a little over before it notices.
+ * RenConstructOrApply() then returns REN_EVAL_STEPS_EXCEEDED or
+ * REN_MEMORY_EXCEEDED.
+ *
+ * Deadlines are left to the host.  RenExceedBudget() can be called from
+ * another thread; it stops the running evaluation as a halt would, except
+ * that RenConstructOrApply() returns REN_BUDGET_EXCEEDED instead of
+ * REN_EVALUATION_HALTED.
+ *
+ * The evaluation may finish before it notices, and then the halt would be
+ * taken by whatever is evaluated next.  RenRetractBudget() withdraws a
+ * RenExceedBudget() that hasn't been acted on yet (and does nothing if it
+ * has been).
+ */
+
+RenResult RenLimitUsage(
+    RenEngineHandle engine,
+    uint64_t maxEvalSteps,
+    uint64_t maxMemoryBytes,
+    uint64_t * evalLimitOut,
+    uint64_t * memoryLimitOut
+);
+
+RenResult RenRestoreUsageLimits(
+    RenEngineHandle engine,
+    uint64_t evalLimit,
+    uint64_t memoryLimit
+);
+
+RenResult RenExceedBudget(RenEngineHandle engine);
+
+RenResult RenRetractBudget(RenEngineHandle engine);
+
 #endif
@@ -19,21 +19,63 @@
 // See http://rencpp.hostilefork.com for more information on this project
 //
 
+#include <cstddef>
+#include <cstdint>
+
 #include "value.hpp"
 
 
 namespace ren {
 
 
+//
+// PIXEL FORMATS
+//
+
+//
+// The runtime keeps an image's pixels as 32-bit 0xAARRGGBB words, with
+// alpha not premultiplied (255 is opaque).  In memory on a little-endian
+// machine that is the bytes B, G, R, A--the same as BGRA8 here, and as
+// QImage::Format_ARGB32.
+//
+// convertPixels() changes count pixels from one layout to another, and
+// may be used in place (from == to).  It is vectorized with SSE2 where
+// that is available, and uses SSSE3 byte shuffles for the plain RGBA/BGRA
+// swap if the build enables them (e.g. -mssse3 or -march=native).
+//
+
+enum class PixelFormat {
+    RGBA8,
+    BGRA8,
+    RGBA8Premultiplied,
+    BGRA8Premultiplied
+};
+
+constexpr PixelFormat nativePixelFormat = PixelFormat::BGRA8;
+
+void convertPixels(
+    void const * from,
+    PixelFormat fromFormat,
+    void * to,
+    PixelFormat toFormat,
+    size_t count
+);
+
+
+class PixelSpan;
+
+
+
 //
 // IMAGE
 //
 
 //
 // Rebol has a native IMAGE! type, which a few codecs have been written for
-// to save and load.  We don't do much with it in RenCpp at this point
-// unless you are building with the Qt classlib, in which case we need to
-// go back and forth with a QImage.
+// to save and load.  RenCpp can make one from a buffer of pixels in any of
+// the formats above, copy its pixels back out, or give a PixelSpan to work
+// on them in place.  With the Qt classlib it can also go back and forth
+// with a QImage.
 //
 // It's not clear if this should be in the standard RenCpp or if it belongs
 // in some kind of extensions module.  In Rebol at least, the IMAGE! was
@@ -48,16 +90,95 @@ namespace ren {
 class Image : public AnyValue {
 protected:
     friend class AnyValue;
+    friend class PixelSpan;
     Image (Dont) noexcept : AnyValue (Dont::Initialize) {}
     inline bool isValid() const { return isImage(); }
 
 public:
+    // A new image, all transparent black
+    Image (size_t width, size_t height, Engine * engine = nullptr);
+
+    // A new image with a copy of the pixels, which are rows of width pixels
+    // that start stride bytes apart
+    Image (
+        void const * pixels,
+        size_t width,
+        size_t height,
+        size_t stride,
+        PixelFormat format,
+        Engine * engine = nullptr
+    );
+
+    size_t width() const;
+    size_t height() const;
+
+    // Copies the pixels out, converted, with rows stride bytes apart
+    void copyPixelsTo(void * pixels, size_t stride, PixelFormat format) const;
+
+    // Reads and writes the pixels where they are, see PixelSpan
+    PixelSpan pixels() const;
+
 #if REN_CLASSLIB_QT == 1
     explicit Image (QImage const & image, Engine * engine = nullptr);
+
+    // The QImage gets its own copy of the pixels
     operator QImage () const;
 #endif
 };
 
+
+
+//
+// PIXEL SPAN
+//
+
+//
+// A view of an image's pixels in the runtime's own memory, in the native
+// format, for code that wants to work on them without copying:
+//
+//     auto span = image.pixels();
+//     for (size_t y = 0; y < span.height(); ++y) {
+//         uint32_t * row = span.row(y);
+//         ...
+//     }
+//
+// The image is kept alive by the span, and is protected while it exists:
+// script code that tries to change it (or its size, which would move the
+// pixels) gets an error instead.  Don't hand the image to the runtime to
+// be modified while holding a span.
+//
+
+class PixelSpan {
+private:
+    friend class Image;
+
+    Image image;
+    uint32_t * bits;
+    size_t w;
+    size_t h;
+    bool pinned; // whether this span protected the image (and unprotects)
+
+    explicit PixelSpan (Image const & image);
+
+public:
+    PixelSpan (PixelSpan const &) = delete;
+    PixelSpan & operator= (PixelSpan const &) = delete;
+
+    PixelSpan (PixelSpan && other);
+
+    uint32_t * data() const noexcept { return bits; }
+    size_t width() const noexcept { return w; }
+    size_t height() const noexcept { return h; }
+    size_t size() const noexcept { return w * h; }
+
+    uint32_t * row(size_t y) const noexcept { return bits + y * w; }
+
+    uint32_t * begin() const noexcept { return bits; }
+    uint32_t * end() const noexcept { return bits + w * h; }
+
+    ~PixelSpan ();
+};
+
 } // end namespace ren
 
 #endif
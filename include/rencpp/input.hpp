@@ -0,0 +1,122 @@
+#ifndef RENCPP_INPUT_HPP
+#define RENCPP_INPUT_HPP
+
+//
+// input.hpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+namespace ren {
+
+//
+// INPUT RING
+//
+
+//
+// By default an Engine reads its input with getline() from an istream, which
+// blocks the evaluating thread until a whole line is there.  A host that
+// gets its input some other way (a GUI console, a socket) would have to
+// write an istream that waits on it.  Instead it can give the engine an
+// InputRing, and push bytes into it from another thread as they come:
+//
+//     ren::InputRing input;
+//     ren::Engine::runFinder().setInputRing(&input);
+//
+//     // on the UI thread
+//     input.write(lineTheUserTyped + "\n");
+//
+// Reads take whatever is there--part of a line, or several lines--rather
+// than a line at a time.  While the ring is empty a read waits in slices,
+// so it can be halted (and an Evaluator keeps running queued jobs, as with
+// awaitFuture in function.hpp).  close() marks the end of input, which
+// reads see once what was written before it has been taken.
+//
+// There is no locking between the two sides: one thread writes and one
+// (the evaluating thread) reads.  With several writers, serialize them.
+// The capacity is rounded up to a power of two, and write() takes only as
+// much as fits, returning how much that was.
+//
+
+class InputRing {
+private:
+    std::unique_ptr<char[]> data;
+    size_t mask;
+
+    // Only the reader moves head, and only the writer moves tail; they run
+    // freely and are masked to index into data
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    std::atomic<bool> closed;
+
+    // Only used to sleep when the ring is empty
+    std::atomic<bool> readerWaiting;
+    std::mutex sleepMutex;
+    std::condition_variable wakeup;
+
+private:
+    void wakeReader();
+
+public:
+    explicit InputRing (size_t capacity = 64 * 1024);
+
+    InputRing (InputRing const &) = delete;
+    InputRing & operator= (InputRing const &) = delete;
+
+    size_t capacity() const noexcept {
+        return mask + 1;
+    }
+
+    // Writer side
+
+    size_t write(char const * bytes, size_t size);
+
+    size_t write(std::string const & bytes) {
+        return write(bytes.data(), bytes.size());
+    }
+
+    void close();
+
+    // Reader side
+
+    size_t available() const noexcept {
+        return tail.load(std::memory_order_acquire)
+            - head.load(std::memory_order_relaxed);
+    }
+
+    // Nothing is left, and nothing more is coming
+    bool atEnd() const noexcept {
+        return closed.load(std::memory_order_acquire) and available() == 0;
+    }
+
+    size_t read(char * bytes, size_t size);
+
+    // Returns false if the timeout passed before there was anything to
+    // read, or the ring was closed
+    bool waitReadable(std::chrono::milliseconds timeout);
+};
+
+} // end namespace ren
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef RENCPP_LOADER_HPP
+#define RENCPP_LOADER_HPP
+
+//
+// loader.hpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <deque>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "value.hpp"
+#include "context.hpp"
+
+
+namespace ren {
+
+namespace internal {
+
+//
+// Finds where top-level values end in source text that arrives in pieces,
+// without scanning it, so each can be loaded on its own.  It knows enough
+// of the syntax to not be fooled by brackets and semicolons in strings and
+// comments; where it can't tell, it keeps text together (loading a piece
+// with two values in it is fine, splitting a value is not).  A value that
+// contains whitespace outside of brackets and strings, such as a tag with
+// attributes, isn't supported.
+//
+
+class ValueSplitter {
+private:
+    enum class Mode {Normal, Quoted, Braced, Comment};
+
+    Mode mode;
+    bool escaped;
+    int braceDepth;
+    int depth;
+
+    bool unwrap;
+    int base;
+    bool started;
+    bool wrapperClosed;
+
+    char const * problem;
+
+    std::string pending;
+
+private:
+    void emit(std::vector<std::string> & out);
+
+public:
+    // If unwrapping, text that starts with a block is taken to be that
+    // block alone, and its items come out one at a time as they close.
+    // Anything but whitespace and comments after the block, or the block
+    // not closing, is a mistake in the text: the rest of it is ignored and
+    // malformed() says what was wrong.
+    explicit ValueSplitter (bool unwrap);
+
+    void feed(char const * data, size_t size, std::vector<std::string> & out);
+
+    void finish(std::vector<std::string> & out);
+
+    size_t pendingSize() const noexcept {
+        return pending.size();
+    }
+
+    char const * malformed() const noexcept {
+        return problem;
+    }
+};
+
+} // end namespace internal
+
+
+
+//
+// STREAM LOADER
+//
+
+//
+// LOAD has to scan all of its input into one block before anything can be
+// done with it, so a file holding millions of records takes memory for all
+// of them at once.  A StreamLoader reads a stream in chunks and gives back
+// one top-level value at a time, keeping only the value being read:
+//
+//     std::ifstream dump {"records.reb"};
+//     ren::StreamLoader loader {dump};
+//
+//     while (auto record = loader.next())
+//         process(*record);
+//
+// A stream that starts with a block is taken to be that one block--as a
+// MOLD/ALL of a block of records would be--and its items are given back
+// as they are read, instead of the block.  (Pass unwrap as false to get
+// the block itself.)  So anything but comments after the block is an
+// error.  Each value is loaded bound into the context given, or the
+// current one; text that won't load throws a load_error from next().
+//
+// Reading from a file descriptor is available on POSIX.
+//
+
+class StreamLoader {
+private:
+    std::istream * input;
+    int fd;
+    std::vector<char> chunk;
+    bool exhausted;
+
+    internal::ValueSplitter splitter;
+    std::vector<std::string> texts;
+    size_t nextText;
+    std::deque<AnyValue> values;
+
+    optional<Context> context;
+
+private:
+    size_t readChunk();
+
+public:
+    explicit StreamLoader (
+        std::istream & input,
+        bool unwrap = true,
+        size_t chunkSize = 64 * 1024
+    );
+
+#ifndef _WIN32
+    explicit StreamLoader (
+        int fd,
+        bool unwrap = true,
+        size_t chunkSize = 64 * 1024
+    );
+#endif
+
+    StreamLoader (StreamLoader const &) = delete;
+    StreamLoader & operator= (StreamLoader const &) = delete;
+
+    void setContext(Context const & newContext) {
+        context = newContext;
+    }
+
+    // nullopt once the stream has run out
+    optional<AnyValue> next();
+};
+
+} // end namespace ren
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef RENCPP_MEMFS_HPP
+#define RENCPP_MEMFS_HPP
+
+//
+// memfs.hpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+
+
+namespace ren {
+
+//
+// IN-MEMORY FILES
+//
+
+//
+// Scripts read and write %files through the runtime's file device, which
+// goes to the disk.  A host that wants to hand a script some data (or get
+// some back) without making temporary files can mount a MemoryFiles under
+// a path instead.  READ, WRITE, LOAD, SAVE, DELETE and RENAME of files under
+// that path then work on the mount, and everything else still goes to disk:
+//
+//     auto files = std::make_shared<ren::MemoryFiles>();
+//     files->add("input.txt", "some text");
+//     files->addMapped("big.dat", "/var/data/big.dat"); // read-only
+//     ren::mountFiles("/mem/", files);
+//
+//     runtime("write %/mem/output.txt uppercase read/string %/mem/input.txt");
+//
+//     auto output = files->get("output.txt"); // optional<std::vector<char>>
+//
+// Files added with add() are copies that scripts may change or replace;
+// writing a new name creates it.  Views and mapped files are read-only and
+// are never copied (the runtime copies what a script reads into its own
+// series, as it would from a disk file).  Names can contain slashes, but
+// the mount has no directories as such: they can't be listed or made.
+//
+// The path is the host's form of it (what TO-LOCAL-FILE gives), and a file
+// is in a mount if its path starts with the mount's.  A MemoryFiles can be
+// used from any thread, and can be mounted in more than one place.
+//
+// Only the Rebol binding has the file device for this at the moment.
+//
+
+class MemoryFiles {
+private:
+    struct File {
+        bool writable;
+        std::vector<char> bytes; // if writable
+
+        char const * view; // if not
+        size_t viewSize;
+        std::shared_ptr<void> owner; // keeps a view alive, if need be
+
+        char const * data() const {
+            return writable ? bytes.data() : view;
+        }
+
+        size_t size() const {
+            return writable ? bytes.size() : viewSize;
+        }
+    };
+
+    mutable std::mutex mutex;
+    std::map<std::string, File> files;
+
+public:
+    MemoryFiles () {
+    }
+
+    MemoryFiles (MemoryFiles const &) = delete;
+    MemoryFiles & operator= (MemoryFiles const &) = delete;
+
+    void add(std::string const & name, std::vector<char> bytes);
+
+    void add(std::string const & name, std::string const & text) {
+        add(name, std::vector<char> {text.begin(), text.end()});
+    }
+
+    // Not copied: the memory must last as long as the file is in the mount
+    void addView(std::string const & name, void const * data, size_t size);
+
+    // Throws std::runtime_error if the host file can't be mapped
+    void addMapped(std::string const & name, std::string const & hostPath);
+
+    bool remove(std::string const & name);
+
+    optional<std::vector<char>> get(std::string const & name) const;
+
+    std::vector<std::string> names() const;
+
+    //
+    // For the file device.  Offsets past the end of a file read nothing,
+    // and writes past the end fill the gap with zeros.
+    //
+public:
+    bool query(std::string const & name, uint64_t * sizeOut) const;
+
+    // Creates the file for writing if it isn't there; fails for a read-only
+    // file, or a missing one if not writing
+    bool open(std::string const & name, bool write, bool truncate);
+
+    size_t read(
+        std::string const & name, uint64_t offset, char * out, size_t size
+    ) const;
+
+    bool write(
+        std::string const & name,
+        uint64_t offset,
+        char const * bytes,
+        size_t size
+    );
+
+    bool rename(std::string const & from, std::string const & to);
+};
+
+
+// The path of a mount is made to end in a slash.  Mounting again at the
+// same path replaces the earlier mount.
+
+void mountFiles(std::string path, std::shared_ptr<MemoryFiles> files);
+
+bool unmountFiles(std::string path);
+
+
+namespace internal {
+    // The mount a host path is in, if any, giving the file's name in it
+    std::shared_ptr<MemoryFiles> findMountedFiles(
+        std::string const & path,
+        std::string * nameOut
+    );
+}
+
+} // end namespace ren
+
+#endif
@@ -0,0 +1,260 @@
+#ifndef RENCPP_POOL_HPP
+#define RENCPP_POOL_HPP
+
+//
+// pool.hpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "value.hpp"
+#include "arrays.hpp"
+#include "error.hpp"
+
+
+namespace ren {
+
+#if defined(REN_RUNTIME) and !defined(_WIN32)
+
+namespace internal {
+    class Spawner;
+}
+
+
+//
+// ENGINE POOL
+//
+
+//
+// A process can only have one engine (Rebol keeps its state in globals),
+// so one process can only evaluate on one core.  An EnginePool gets around
+// that by keeping a number of worker processes, each with its own copy of
+// the runtime, and handing evaluations to whichever is free:
+//
+//     ren::EnginePool pool;
+//
+//     auto sum = pool("1 + 2"); // same shape as ren::runtime(...)
+//
+//     std::vector<std::future<optional<std::string>>> results;
+//     for (auto & job : jobs)
+//         results.push_back(pool.submit(job)); // from any thread
+//
+// The workers are forked from a snapshot of this process taken when the
+// pool is constructed, so anything defined in the runtime by then (words,
+// contexts, natives made with Function::construct) is there in every
+// worker.  Changes made afterwards--on either side--are not shared, and
+// each evaluation in a worker can see what earlier ones in that same
+// worker left behind.  Construct the pool early, before the host starts
+// other threads.
+//
+// submit() takes source text and gives the molded result (or nullopt for
+// no value), so it can be called from any thread, runtime or not.
+// operator() and evaluate() exchange values in the binary form of
+// serialize.hpp instead, so nothing is molded or scanned on the way; that
+// is done with the runtime of the calling thread, and any value that can
+// be serialized (which is all but functions) can be passed.
+//
+// There are at most maxPending evaluations waiting for a worker; past that,
+// submit() blocks until one is taken.  If a worker dies the evaluation it
+// was running fails with worker_lost and a new worker takes its place.
+// Given a job timeout, a worker that hasn't started answering by then is
+// killed and replaced the same way, and the evaluation fails with
+// worker_timeout.
+//
+// This header is not included by ren.hpp, and is only available on POSIX.
+// See also Zygote, below, for running each evaluation in a fresh process.
+//
+
+class worker_error : public std::exception {
+private:
+    std::string whatString;
+
+public:
+    worker_error (std::string const & whatString) :
+        whatString (whatString)
+    {
+    }
+
+    char const * what() const noexcept override {
+        return whatString.c_str();
+    }
+};
+
+
+class worker_lost : public std::exception {
+public:
+    worker_lost ()
+    {
+    }
+
+    char const * what() const noexcept override {
+        return "ren::worker_lost";
+    }
+};
+
+
+class worker_timeout : public worker_lost {
+public:
+    worker_timeout ()
+    {
+    }
+
+    char const * what() const noexcept override {
+        return "ren::worker_timeout";
+    }
+};
+
+
+class EnginePool {
+private:
+    struct Job {
+        std::string request; // see evaluateForReply() in pool.cpp
+        std::promise<optional<std::string>> promise;
+    };
+
+    struct Worker {
+        std::thread thread;
+        int pid;
+        int fd;
+    };
+
+    std::unique_ptr<internal::Spawner> spawner;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex mutex;
+    std::condition_variable jobAdded;
+    std::condition_variable jobTaken;
+    std::deque<Job> pending;
+    size_t maxPending;
+    std::chrono::milliseconds jobTimeout;
+    bool stopping;
+
+    std::atomic<size_t> restartCount;
+
+private:
+    std::future<optional<std::string>> submitRequest(std::string request);
+
+    void serve(Worker & worker);
+    bool restart(Worker & worker);
+
+public:
+    // A worker count of zero means one per hardware thread, a maxPending of
+    // zero means four evaluations waiting per worker, and a jobTimeout of
+    // zero means evaluations may take as long as they like
+    explicit EnginePool (
+        size_t numWorkers = 0,
+        size_t maxPending = 0,
+        std::chrono::milliseconds jobTimeout = std::chrono::milliseconds {0}
+    );
+
+    EnginePool (EnginePool const &) = delete;
+    EnginePool & operator= (EnginePool const &) = delete;
+
+    // Source text is run as if by DO.  An error raised by the evaluation
+    // comes back as a worker_error carrying its FORMed message.
+    std::future<optional<std::string>> submit(std::string source);
+
+    // Errors raised by the evaluation are rethrown as evaluation_error
+    optional<AnyValue> evaluate(Block const & code);
+
+    template <typename... Ts>
+    optional<AnyValue> operator()(Ts const &... args) {
+        return evaluate(Block {args...});
+    }
+
+    size_t size() const noexcept {
+        return workers.size();
+    }
+
+    // How many times a worker has had to be replaced
+    size_t restarts() const noexcept {
+        return restartCount.load();
+    }
+
+    // Pending evaluations are abandoned (their futures get broken_promise),
+    // and ones in progress are stopped
+    ~EnginePool ();
+};
+
+
+//
+// ZYGOTE
+//
+
+//
+// Booting the runtime takes tens of milliseconds, which is a lot to pay
+// for each evaluation that ought to start with a clean slate (for instance,
+// running untrusted scripts one at a time).  A Zygote pays it once: the
+// runtime is started, the preload code is run (to DO packages and such),
+// and a snapshot of the process is taken.  After that, each run() forks a
+// fresh child from the snapshot--sharing its memory copy-on-write--which
+// evaluates the one piece of code, answers, and exits.
+//
+//     ren::Zygote zygote {Block {"do %my-package.reb"}};
+//
+//     auto result = zygote("my-package/process", data);
+//
+// Nothing an evaluation does is seen by the next one, or by this process.
+// As with EnginePool, run() takes source text and gives molded text, and
+// evaluate() passes values serialized.  run() can be called from any
+// thread, and a child that dies fails the call with worker_lost.
+//
+
+class Zygote {
+private:
+    std::unique_ptr<internal::Spawner> spawner;
+
+    optional<std::string> runRequest(std::string const & request);
+
+public:
+    Zygote ();
+
+    explicit Zygote (Block const & preload);
+
+    Zygote (Zygote const &) = delete;
+    Zygote & operator= (Zygote const &) = delete;
+
+    // Source text is run as if by DO; errors come back as worker_error
+    optional<std::string> run(std::string const & source);
+
+    // Errors raised by the evaluation are rethrown as evaluation_error
+    optional<AnyValue> evaluate(Block const & code);
+
+    template <typename... Ts>
+    optional<AnyValue> operator()(Ts const &... args) {
+        return evaluate(Block {args...});
+    }
+
+    ~Zygote ();
+};
+
+#endif
+
+} // end namespace ren
+
+#endif
@@ -19,6 +19,7 @@
 // See http://rencpp.hostilefork.com for more information on this project
 //
 
+#include <chrono>
 #include <mutex>
 #include "runtime.hpp"
 
@@ -28,10 +29,44 @@
 
 namespace ren {
 
+class Engine;
+
 namespace internal {
     class RebolHooks;
 }
 
+//
+// STARTUP TIMINGS
+//
+
+//
+// The runtime is started lazily, by the first thing that needs it, and the
+// startup can take a noticeable fraction of a short-lived program's run.
+// startupTimings() breaks down where that time went; everything is zero
+// until the runtime has been started (e.g. by `runtime("none")`).
+//
+// If the startup itself is the bottleneck--e.g. running many sandboxed
+// scripts--see ren::Zygote in pool.hpp, which pays for it only once.
+//
+
+struct StartupTimings {
+    // Init_Core: memory pools, datatypes, natives, the boot block
+    std::chrono::nanoseconds initCore;
+
+    // Init_Core_Ext: registering the built-in extensions
+    std::chrono::nanoseconds initExtensions;
+
+    // RL_START: running the mezzanine's SYS startup
+    std::chrono::nanoseconds startMezzanine;
+
+    // Replacing APPLY with the binding's generalized apply
+    std::chrono::nanoseconds patchApply;
+
+    // Everything, including the above
+    std::chrono::nanoseconds total;
+};
+
+
 // Not only is Runtime implemented on a per-binding basis
 // (hence not requiring virtual methods) but you can add more
 // specialized methods that are peculiar to just this runtime
@@ -43,6 +78,12 @@ private:
 
     REBARGS rebargs;
 
+    StartupTimings timings;
+
+    // Rebol only has one engine at a time, so the stdio device looks it up
+    // once instead of on every read and write; forgotten when it's freed
+    Engine * stdioEngine;
+
 private:
     static REBVAL loadAndBindWord(
         REBSER * context,
@@ -64,6 +105,12 @@ public:
 
     void doMagicOnlyRebolCanDo();
 
+    StartupTimings const & startupTimings() const {
+        return timings;
+    }
+
+    Engine & getStdioEngine();
+
     void cancel() override;
 
     ~RebolRuntime() override;
@@ -72,9 +119,20 @@ public:
 extern RebolRuntime runtime;
 
 namespace internal {
+    // Puts the in-memory file mounts in front of the file device (see
+    // memfs.hpp and rebol-memfs.cpp)
+    void installMemoryFileDevice();
+
     // Placeholder for better solution: mutex for management of linked list
     extern std::mutex linkMutex;
     extern ren::AnyValue * head;
+
+    // A source text Loadable is an alien (REB_END) cell with the text in
+    // its series slot and the length in its index slot.  Rebol's scanner
+    // is given the length but still stops on a NUL in places, so this bit
+    // of the index marks text known to have one after it; any other text
+    // is copied into a terminated buffer to be scanned.
+    constexpr REBCNT loadableTerminated = 0x80000000;
 }
 
 } // end namespace ren
@@ -35,9 +35,11 @@
 #include "strings.hpp"
 #include "arrays.hpp"
 #include "error.hpp"
+#include "result.hpp"
 #include "function.hpp"
 #include "runtime.hpp"
 #include "engine.hpp"
+#include "input.hpp"
 #include "context.hpp"
 
 // !!! Even non-GUI builds want to be able to process images.  Yet this
@@ -45,6 +47,10 @@
 // (once plug-ins can act like fairly natural types)
 #include "image.hpp"
 
+#include "visit.hpp"
+
+#include "evaluator.hpp"
+
 
 //
 // INCLUDE REBOL OR RED RUNTIME INSTANCE
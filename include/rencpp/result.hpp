@@ -0,0 +1,199 @@
+#ifndef RENCPP_RESULT_HPP
+#define RENCPP_RESULT_HPP
+
+//
+// result.hpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+#include "value.hpp"
+#include "error.hpp"
+
+
+namespace ren {
+
+//
+// NON-THROWING RESULTS
+//
+
+//
+// Failures in loading and evaluation are raised as C++ exceptions by
+// apply() and evaluate(): load_error, evaluation_error and evaluation_throw.
+// That is the right thing when failure is unusual, but some scripts fail as
+// a matter of course (a PARSE rule that rejects its input, a validation that
+// raises an error) and then the unwinding adds up.  tryApply() and
+// tryEvaluate() give back a Result instead, which holds either what the
+// throwing call would have returned or what went wrong:
+//
+//     auto result = runtime.tryEvaluate({"parse", input, rules});
+//     if (not result) {
+//         if (result.failure() == ren::Failure::EvaluationError)
+//             ...result.error()...
+//     }
+//     else if (*result and static_cast<bool>(**result))
+//         ...
+//
+// Nothing is formatted for a failure unless asked--the error is held as
+// the ERROR! value.  value() on a failed Result throws the exception the
+// throwing call would have (which is how those calls are implemented).
+//
+// Halting (evaluation_halt and budget_exceeded) is not an outcome of the
+// script but a request to stop, so it is thrown by the try calls as well.
+//
+
+enum class Failure {
+    None, // the Result holds a value
+    LoadError,
+#ifdef REN_RUNTIME
+    EvaluationError,
+    Throw
+#endif
+};
+
+
+namespace internal {
+
+// What a Result holds besides the value, which is all there is to a
+// failed one; it is how a failure is passed from one Result type to another
+
+class ResultBase {
+protected:
+    Failure failureKind;
+    optional<AnyValue> failureValue; // the error, or the thrown value
+    optional<AnyValue> failureName; // the /NAME of a throw
+
+public:
+    ResultBase () : failureKind (Failure::None) {}
+
+    ResultBase (
+        Failure failure,
+        optional<AnyValue> const & value,
+        optional<AnyValue> const & name = nullopt
+    ) :
+        failureKind (failure),
+        failureValue (value),
+        failureName (name)
+    {
+    }
+
+    Failure failure() const noexcept {
+        return failureKind;
+    }
+
+    bool hasValue() const noexcept {
+        return failureKind == Failure::None;
+    }
+
+    explicit operator bool() const noexcept {
+        return hasValue();
+    }
+
+    // The ERROR! of a LoadError or EvaluationError
+    Error error() const {
+        bool holdsError = failureKind == Failure::LoadError;
+    #ifdef REN_RUNTIME
+        holdsError = holdsError or failureKind == Failure::EvaluationError;
+    #endif
+        if (not holdsError or failureValue == nullopt)
+            throw std::logic_error {"ren::Result does not hold an error"};
+        return static_cast<Error>(*failureValue);
+    }
+
+#ifdef REN_RUNTIME
+    // The value and name of a Throw, either of which may be absent
+    optional<AnyValue> const & thrownValue() const noexcept {
+        return failureValue;
+    }
+
+    optional<AnyValue> const & throwName() const noexcept {
+        return failureName;
+    }
+#endif
+
+    // Throws the exception that the throwing API would have
+    [[noreturn]] void rethrow() const {
+        switch (failureKind) {
+        case Failure::LoadError:
+            throw load_error {error()};
+
+    #ifdef REN_RUNTIME
+        case Failure::EvaluationError:
+            throw evaluation_error {error()};
+
+        case Failure::Throw:
+            throw evaluation_throw {failureValue, failureName};
+    #endif
+
+        case Failure::None:
+        default:
+            throw std::logic_error {"ren::Result holds no failure to rethrow"};
+        }
+    }
+};
+
+} // end namespace internal
+
+
+
+template <class T>
+class Result : public internal::ResultBase {
+private:
+    optional<T> valueSlot;
+
+public:
+    Result (T const & value) :
+        valueSlot (value)
+    {
+    }
+
+    Result (T && value) :
+        valueSlot (std::move(value))
+    {
+    }
+
+    // Takes on the failure of another Result (of any type)
+    explicit Result (internal::ResultBase const & failed) :
+        internal::ResultBase (failed)
+    {
+        assert(not failed.hasValue());
+    }
+
+    T & value() {
+        if (not hasValue())
+            rethrow();
+        return *valueSlot;
+    }
+
+    T const & value() const {
+        if (not hasValue())
+            rethrow();
+        return *valueSlot;
+    }
+
+    // Unchecked, like std::optional; test the Result first
+    T & operator*() { return *valueSlot; }
+    T const & operator*() const { return *valueSlot; }
+    T * operator->() { return &*valueSlot; }
+    T const * operator->() const { return &*valueSlot; }
+};
+
+} // end namespace ren
+
+#endif
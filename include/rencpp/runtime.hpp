@@ -19,11 +19,15 @@
 // See http://rencpp.hostilefork.com for more information on this project
 //
 
+#include <chrono>
+#include <cstdint>
 #include <initializer_list>
+#include <string>
 
 #include "common.hpp"
 #include "value.hpp"
 #include "arrays.hpp"
+#include "result.hpp"
 
 
 namespace ren {
@@ -49,6 +53,51 @@ namespace ren {
 // than the paren notation
 //
 
+//
+// EVALUATION BUDGETS
+//
+
+//
+// One runaway script shouldn't be able to hold the evaluator forever.  An
+// evaluation can be given a budget:
+//
+//     runtime.evaluate(
+//         {"loop 1000000000 [append [] 1]"},
+//         Budget {std::chrono::steady_clock::now() + std::chrono::seconds(1)}
+//     );
+//
+// If it runs past the deadline, takes more than maxEvalSteps evaluator
+// steps, or has the runtime allocate more than maxMemoryBytes beyond what
+// it had when the evaluation began, it is halted and budget_exceeded is
+// thrown.  Zero (or a default time_point) means no limit.  Steps and
+// memory are checked by the evaluator as it runs; steps are only tallied
+// each time it stops to check for signals, so an evaluation can go a little
+// over before it is stopped.  Deadlines are kept by a watchdog thread that
+// sleeps until the nearest one.
+//
+// Budgeted evaluations may nest (say, in a native called by one); each
+// is held to its own budget as well as those of all the enclosing ones.
+//
+
+struct Budget {
+    std::chrono::steady_clock::time_point deadline;
+    uint64_t maxEvalSteps;
+    uint64_t maxMemoryBytes;
+
+    Budget (
+        std::chrono::steady_clock::time_point deadline = {},
+        uint64_t maxEvalSteps = 0,
+        uint64_t maxMemoryBytes = 0
+    ) :
+        deadline (deadline),
+        maxEvalSteps (maxEvalSteps),
+        maxMemoryBytes (maxMemoryBytes)
+    {
+    }
+};
+
+
+
 class Runtime {
 protected:
     friend class AnyArray;
@@ -84,6 +133,45 @@ public:
         );
     }
 
+    static optional<AnyValue> evaluate(
+        std::initializer_list<internal::Loadable> loadables,
+        Budget const & budget,
+        Engine * engine = nullptr
+    );
+
+    // As evaluate(), but with a failure to load or evaluate handed back in
+    // the Result instead of thrown (see result.hpp)
+
+protected:
+    static Result<optional<AnyValue>> tryEvaluate(
+        internal::Loadable const loadables[],
+        size_t numLoadables,
+        Context const * contextPtr,
+        Engine * engine
+    );
+
+public:
+    static Result<optional<AnyValue>> tryEvaluate(
+        std::initializer_list<internal::Loadable> loadables,
+        Engine * engine = nullptr
+    ) {
+        return tryEvaluate(
+            loadables.begin(), loadables.size(), nullptr, engine
+        );
+    }
+
+    static Result<optional<AnyValue>> tryEvaluate(
+        std::initializer_list<internal::BlockLoadable<Block>> loadables,
+        internal::ContextWrapper const & wrapper
+    ) {
+        return tryEvaluate(
+            loadables.begin(),
+            loadables.size(),
+            &wrapper.context,
+            nullptr
+        );
+    }
+
     // Has ambiguity error from trying to turn the nullptr into a Loadable;
     // investigate what it is about the static method that has this problem
 
@@ -98,6 +186,42 @@ public:
     }
 
 
+    //
+    // Script files are loaded by memory-mapping them and scanning the
+    // mapping where it is, instead of reading them into a string first (which
+    // passing a std::string as a Loadable would take).  Words are bound into
+    // the context given, or the current one.  A file that can't be mapped
+    // gives std::runtime_error, and one that won't scan a load_error.
+    //
+    // doFile() evaluates the loaded block, as DO of a file would, except
+    // that any script header is just evaluated along with the rest.
+    //
+
+    // What loadFile() does once it has the text.  The text needs no NUL
+    // after it, but Rebol's scanner does, and copies text without one;
+    // saying it's terminated (that utf8[size] is a NUL) is the only way
+    // it is scanned in place.
+    static Block loadUtf8(
+        char const * utf8,
+        size_t size,
+        Context const * contextPtr = nullptr,
+        Engine * engine = nullptr,
+        bool terminated = false
+    );
+
+    static Block loadFile(
+        std::string const & path,
+        Context const * contextPtr = nullptr,
+        Engine * engine = nullptr
+    );
+
+    static optional<AnyValue> doFile(
+        std::string const & path,
+        Context const * contextPtr = nullptr,
+        Engine * engine = nullptr
+    );
+
+
     //
     // How to do a cancellation interface properly in threading environments
     // which may be making many requests?  This simple interface assumes one
@@ -115,6 +239,15 @@ public:
 };
 
 
+
+inline Block loadFile(std::string const & path) {
+    return Runtime::loadFile(path);
+}
+
+inline Block loadFile(std::string const & path, Context const & context) {
+    return Runtime::loadFile(path, &context);
+}
+
 } // end namespace ren
 
 
@@ -0,0 +1,126 @@
+#ifndef RENCPP_SERIALIZE_HPP
+#define RENCPP_SERIALIZE_HPP
+
+//
+// serialize.hpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <cstddef>
+#include <exception>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "value.hpp"
+
+
+namespace ren {
+
+#ifdef REN_RUNTIME
+
+//
+// BINARY SERIALIZATION
+//
+
+//
+// MOLD and LOAD will take values from one process to another, but the text
+// is bulky and has to be scanned again on the other side.  serialize()
+// writes a value in a compact binary form instead, which deserialize()
+// reads back:
+//
+//     std::ofstream cache {"results.bin", std::ios::binary};
+//     ren::serialize(results, cache);
+//     ...
+//     Block results = static_cast<Block>(ren::deserialize(bytes));
+//
+// Numbers are written at fixed width, and each distinct word spelling is
+// written once and then referred to by number.  A series that is reached
+// more than once (the same block in two places, or two positions in one
+// string) is also written once, and comes back as one series--so changes
+// made through one reference are seen through the others, as before.
+// A series that contains itself can't be serialized.
+//
+// Words come back bound as a new ren::Word would be, not to wherever they
+// were bound when written.  Datatypes that the format has no encoding for
+// (dates, URLs, objects...) are written as MOLD/ALL text and LOADed, so
+// they are only as faithful as that round trip; a function can't be
+// serialized.
+//
+// Deserializing from memory (a string_view) reads the string and binary
+// contents straight from the buffer into the new series, with no copy in
+// between.
+//
+// The format, all integers little-endian:
+//
+//     stream:  'R' 'E' 'N' version(1)  value
+//
+//     value:   code(1) payload, where by code:
+//         none, false, true    -
+//         char                 u32 codepoint
+//         integer              i64
+//         float                f64 (IEEE 754 bits)
+//         word kinds           symbol
+//         array kinds          series  [u32 count, value...]  u32 index
+//         string kinds         series  [u32 size, UTF-8...]  u32 index
+//         binary               series  [u32 size, bytes...]  u32 index
+//         molded               u32 size, UTF-8 MOLD/ALL text
+//
+//     symbol:  u32 number, and if it is the next unused number, the
+//              spelling follows as u32 size, UTF-8
+//     series:  the same, except what follows a new number is the content
+//              in brackets above (from the head of the series); the index
+//              after it is where in the series this value is positioned
+//
+// A reader rejects a version other than its own serialization_version.
+//
+
+class serialization_error : public std::exception {
+private:
+    std::string whatString;
+
+public:
+    serialization_error (std::string const & whatString) :
+        whatString (whatString)
+    {
+    }
+
+    char const * what() const noexcept override {
+        return whatString.c_str();
+    }
+};
+
+
+constexpr unsigned char serialization_version = 2;
+
+
+void serialize(AnyValue const & value, std::ostream & sink);
+
+std::string serialize(AnyValue const & value);
+
+
+// Errors in the data (including data that ends early) throw
+// serialization_error
+
+AnyValue deserialize(std::istream & source, Engine * engine = nullptr);
+
+AnyValue deserialize(string_view buffer, Engine * engine = nullptr);
+
+#endif
+
+} // end namespace ren
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef RENCPP_STARTUP_HPP
+#define RENCPP_STARTUP_HPP
+
+//
+// startup.hpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <cstddef>
+
+
+namespace ren {
+
+//
+// STARTUP SCRIPTS
+//
+
+//
+// A host often has helper code of its own that should be in place before
+// anything else is evaluated.  Rather than reading it from files (or Qt
+// resources) at launch, it can be linked into the executable and run just
+// before the first evaluation, in the user context.
+//
+// The easy way is to have the build do it.  embed_startup_scripts() in the
+// top-level CMakeLists.txt LOADs script files at build time, with the
+// ren-prescan tool, and turns the blocks (as serialize() writes them) into
+// a generated source file that registers them:
+//
+//     embed_startup_scripts(HELPER_SOURCES helpers.reb dialects.reb)
+//     add_executable(my-app main.cpp ${HELPER_SOURCES})
+//
+// So the host's code isn't scanned each time it starts, only deserialized.
+// Or register source text directly, which is scanned when it is run:
+//
+//     static ren::StartupScript helpers {"helpers", helpersSource};
+//
+// Either must be registered before the first evaluation, and stay valid
+// until then.  Scripts run in the order registered; an error in one is
+// thrown from that first evaluation.
+//
+
+class Engine;
+
+void addStartupScript(char const * name, char const * source);
+
+void addStartupScript(
+    char const * name, unsigned char const * serialized, size_t size
+);
+
+struct StartupScript {
+    StartupScript (char const * name, char const * source) {
+        addStartupScript(name, source);
+    }
+
+    StartupScript (
+        char const * name, unsigned char const * serialized, size_t size
+    ) {
+        addStartupScript(name, serialized, size);
+    }
+};
+
+
+namespace internal {
+    struct StartupScriptEntry {
+        char const * name;
+        char const * data; // source text, or serialized if size isn't 0
+        size_t size;
+    };
+
+    // Called by each evaluation, and runs the scripts the first time.
+    // Registering after that is an error.
+    void runStartupScripts(Engine * engine);
+}
+
+} // end namespace ren
+
+#endif
@@ -27,6 +27,11 @@
 #include <utility> // std::forward
 
 #include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <type_traits>
 
 #include <typeinfo> // std::bad_cast
@@ -70,6 +75,9 @@ class Context;
 
 class Engine;
 
+template <class T>
+class Result; // see result.hpp
+
 
 namespace internal {
     //
@@ -94,6 +102,15 @@ namespace internal {
     template <class R, class... Ts>
     class FunctionGenerator;
 
+    template <class R, class... Fs>
+    class VisitTable;
+
+    class Serializer;
+    class Deserializer;
+
+    template <class T, class Enable = void>
+    struct CellCodec;
+
     // We want to be able to pass a Context to the constructors.  However, the
     // Context itself is a legal Ren type!  This "ContextWrapper" is used to
     // carry a context without itself being a candidate to be a Loadable.
@@ -180,6 +197,138 @@ namespace internal {
 
 using CellFunction = bool (AnyValue::*)(RenCell *) const;
 
+
+//
+// The kind is a coarse classification of a cell by which of the binding's
+// classes could hold it.  It is internal, and is only used to index
+// compile-time tables (see visit.hpp) so a dispatch does not need to run
+// through a chain of isXXX() tests.  Ranges are tested by the tables, so
+// keep the word, array, and string kinds contiguous.
+//
+
+enum class Kind : unsigned char {
+    Other, // datatypes with no specific class in the binding yet
+
+    Unset, // only seen in arrays, but isAtom() takes it
+    None,
+    Logic,
+    Character,
+    Integer,
+    Float,
+    Date,
+    Time,
+    Pair,
+    Tuple,
+
+    Word,
+    SetWord,
+    GetWord,
+    LitWord,
+    Refinement,
+    Issue,
+
+    Block,
+    Group,
+    Path,
+    SetPath,
+    GetPath,
+    LitPath,
+
+    String,
+    Tag,
+    Filename,
+    OtherString, // URL!, the one other type isAnyString() takes
+
+    Function,
+    Context,
+    Error,
+    Image,
+
+    Max
+};
+
+
+//
+// The what() of an exception carrying values is made with to_string(),
+// which molds them.  LazyWhat defers that until what() is actually called,
+// as a catcher will often just look at the value itself.  Copies of the
+// exception share the string, so it is made at most once.  If making it
+// fails, what() gives the fallback instead.
+//
+// Making the string calls into the runtime, so it must be done on a thread
+// that may use the runtime.  A thread whose exceptions are caught on other
+// threads (like ren::Evaluator's) sets whatHome, and what() asked for on
+// another thread then has the string made there, waiting for it.  If that
+// thread has gone, what() gives the fallback.
+//
+
+struct WhatHome {
+    std::thread::id thread;
+
+    std::mutex mutex;
+
+    // Runs its argument on the thread and waits; empty once the thread can
+    // no longer do it.  Guarded by the mutex.
+    std::function<void(std::function<void()> const &)> run;
+};
+
+extern thread_local std::shared_ptr<WhatHome> whatHome;
+
+class LazyWhat {
+private:
+    struct State {
+        std::once_flag once;
+        std::string whatString;
+        bool failed;
+        std::shared_ptr<WhatHome> home;
+
+        State () : failed (false), home (whatHome) {}
+    };
+
+    std::shared_ptr<State> state;
+
+public:
+    LazyWhat () : state (std::make_shared<State>()) {}
+
+    template <class Formatter>
+    char const * get(
+        Formatter const & format,
+        char const * fallback
+    ) const noexcept {
+        State & s = *state;
+        try {
+            std::call_once(s.once, [&]() {
+                std::function<void()> formatHere = [&]() {
+                    try {
+                        s.whatString = format();
+                    }
+                    catch (...) {
+                        s.failed = true;
+                    }
+                };
+
+                if (
+                    not s.home
+                    or s.home->thread == std::this_thread::get_id()
+                ) {
+                    formatHere();
+                    return;
+                }
+
+                std::lock_guard<std::mutex> lock {s.home->mutex};
+                if (s.home->run)
+                    s.home->run(formatHere);
+                else
+                    s.failed = true;
+            });
+        }
+        catch (...) {
+            return fallback;
+        }
+        return s.failed ? fallback : s.whatString.c_str();
+    }
+};
+
 }
 
 
@@ -289,12 +438,32 @@ protected:
     bool tryFinishInit(RenEngineHandle engine);
 
     inline void finishInit(RenEngineHandle engine) {
+        // UNSET! is the only thing refused, as no AnyValue class holds it
         if (!tryFinishInit(engine))
-            throw std::runtime_error {"put meaningful error here"};
+            throw bad_value_cast {
+                "UNSET! can't be held by a ren::AnyValue"
+                " (no value is a disengaged ren::optional)"
+            };
     }
 
     void uninitialize();
 
+    //
+    // A "borrowed" value is one whose cell is known to be kept alive by
+    // something else for as long as the C++ object exists--such as an
+    // argument to a native, which the call frame protects.  It is not put
+    // in the tracking list, and is marked by pointing prev at itself (which
+    // a tracked value never does).  Copying or moving from a borrowed value
+    // goes through finishInit() as usual, so anything that outlives the
+    // borrow is promoted to a tracked value.
+    //
+
+    bool tryFinishBorrow(RenEngineHandle engine);
+
+    bool isBorrowed_() const noexcept {
+        return prev == this;
+    }
+
     //
     // The value-from-cell constructor does not check the bits, and all cell
     // based constructors are not expected to either.  You trust they were
@@ -308,6 +477,18 @@ protected:
     template <class R, class... Ts>
     friend class internal::FunctionGenerator;
 
+    template <class R, class... Fs>
+    friend class internal::VisitTable;
+
+    template <class T, class Enable>
+    friend struct internal::CellCodec;
+
+    friend class internal::Serializer;
+    friend class internal::Deserializer;
+
+    // Implemented by each binding as a single switch on the cell's type
+    internal::Kind kindOf_() const noexcept;
+
     explicit AnyValue (RenCell const & cell, RenEngineHandle engine) noexcept {
         this->cell = cell;
         finishInit(engine);
@@ -355,6 +536,31 @@ protected:
     }
 
 
+    // Borrowing counterpart of fromCell_, for a cell whose lifetime is
+    // guaranteed by the caller (see tryFinishBorrow).  If the compiler does
+    // not elide the copy of the result, the move will promote it; that is
+    // slower but still correct.
+
+    template<
+        class T,
+        typename = typename std::enable_if<
+            std::is_base_of<AnyValue, T>::value
+        >::type
+    >
+    static T borrowCell_(
+        RenCell const & cell, RenEngineHandle engine
+    ) {
+        T result (Dont::Initialize);
+        result.cell = cell;
+        if (!result.tryFinishBorrow(engine))
+            throw bad_value_cast {
+                "UNSET! can't be borrowed as a ren::AnyValue class"
+                " (take a ren::optional to accept no value)"
+            };
+        return result;
+    }
+
+
 public:
     static void toCell_(
         RenCell & cell, AnyValue const & value
@@ -469,6 +675,10 @@ public:
 
     bool isTime() const;
 
+    bool isPair() const;
+
+    bool isTuple() const;
+
     bool isImage() const;
 
 public:
@@ -660,6 +870,27 @@ public:
     inline optional<AnyValue> apply(Ts const &... args) const {
         return apply({ args... });
     }
+
+    // As apply(), but with failures handed back instead of thrown (see
+    // result.hpp, which must be included to use these)
+protected:
+    Result<optional<AnyValue>> tryApply_(
+        internal::Loadable const loadables[],
+        size_t numLoadables,
+        Context const * contextPtr = nullptr,
+        Engine * engine = nullptr
+    ) const;
+
+public:
+    Result<optional<AnyValue>> tryApply(
+        std::initializer_list<internal::Loadable> loadables,
+        internal::ContextWrapper const & wrapper
+    ) const;
+
+    Result<optional<AnyValue>> tryApply(
+        std::initializer_list<internal::Loadable> loadables,
+        Engine * engine = nullptr
+    ) const;
 #endif
 
 
@@ -745,6 +976,18 @@ protected:
         AnyValue * constructOutTypeIn,
         AnyValue * applyOut
     );
+
+    // The same, except that a failure to load or evaluate is given back in
+    // the Result rather than thrown (halts are still thrown)
+    static Result<bool> tryConstructOrApplyInitialize(
+        RenEngineHandle engine,
+        Context const * context,
+        AnyValue const * applicand,
+        internal::Loadable const loadables[],
+        size_t numLoadables,
+        AnyValue * constructOutTypeIn,
+        AnyValue * applyOut
+    );
 };
 
 inline std::ostream & operator<<(std::ostream & os, AnyValue const & value) {
@@ -780,7 +1023,7 @@ class evaluation_throw : public std::exception {
 private:
 	optional<AnyValue> thrownValue; // throw might not have a value, e.g. return
     optional<AnyValue> throwName;
-    std::string whatString;
+    internal::LazyWhat lazyWhat;
 
 public:
     evaluation_throw (
@@ -790,28 +1033,27 @@ public:
         thrownValue (value),
         throwName (name)
     {
-		if (name == nullopt) {
-			whatString = std::string("THROW:");
-			whatString += " ";
-			if (thrownValue == nullopt)
-				whatString += "(no value)";
-			else
-				whatString += to_string(*thrownValue);
-		}
-		else {
-			whatString = std::string("THROW/NAME:");
-			whatString += " ";
-			if (thrownValue == nullopt)
-				whatString += "(no value)";
-			else
-				whatString += to_string(*thrownValue);
-			whatString += " ";
-			whatString += to_string(*throwName);
-        }
     }
 
+    // The thrown value may be big, and is only molded if this is called
     char const * what() const noexcept override {
-        return whatString.c_str();
+        return lazyWhat.get(
+            [this]() {
+                std::string whatString = throwName == nullopt
+                    ? "THROW: "
+                    : "THROW/NAME: ";
+                if (thrownValue == nullopt)
+                    whatString += "(no value)";
+                else
+                    whatString += to_string(*thrownValue);
+                if (throwName != nullopt) {
+                    whatString += " ";
+                    whatString += to_string(*throwName);
+                }
+                return whatString;
+            },
+            "ren::evaluation_throw"
+        );
     }
 
 	optional<AnyValue> const & value() const noexcept {
@@ -881,6 +1123,17 @@ public:
 
     Loadable (char const * source);
 
+    // Like char const *, a string_view is loaded as source.  Its length is
+    // kept in the cell, so the text can be part of a larger buffer (with no
+    // terminator) and the caller needn't make a std::string of it.  That is
+    // NOT zero copy on Rebol: its scanner only reliably stops on a NUL, so
+    // text not known to have one after it is copied into a scratch series
+    // for the scan.  To scan a buffer in place there, reserve a NUL after
+    // the text and use Runtime::loadUtf8() with terminated set, as
+    // loadFile() does.  The view must stay valid until the Loadable has
+    // been used.
+    Loadable (string_view source);
+
     template <typename T>
     Loadable (std::initializer_list<T> loadables) = delete;
 
@@ -0,0 +1,247 @@
+#ifndef RENCPP_VISIT_HPP
+#define RENCPP_VISIT_HPP
+
+//
+// visit.hpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "value.hpp"
+#include "atoms.hpp"
+#include "words.hpp"
+#include "series.hpp"
+#include "strings.hpp"
+#include "arrays.hpp"
+#include "error.hpp"
+#include "function.hpp"
+#include "context.hpp"
+#include "image.hpp"
+
+
+namespace ren {
+
+
+//
+// VISIT
+//
+
+//
+// Code that has to do something different for each type of value it is
+// handed tends to be written as a ladder of tests and casts:
+//
+//     if (value.isBlock()) { ... static_cast<Block>(value) ... }
+//     else if (value.isString()) { ... static_cast<String>(value) ... }
+//     else ...
+//
+// Each rung costs a call into the binding, and each cast re-checks the type
+// it was just told about and makes a copy of the value (which for GC-aware
+// types means taking the lock on the tracking list).  ren::visit() takes
+// a list of overloads instead:
+//
+//     auto size = ren::visit(value,
+//         [](Block const & b) { return b.length(); },
+//         [](AnyString const & s) { return s.length(); },
+//         [](AnyValue const &) { return 0; }
+//     );
+//
+// The value's type is classified once, and used to index a table built at
+// compile time which has the first overload (in the order given) whose
+// parameter class could hold that type.  The overload is then called with
+// that class made on the same cell, borrowed rather than tracked (see
+// AnyValue::tryFinishBorrow), so there's no re-check and no lock taken.  If
+// no overload accepts the type then bad_value_cast is thrown, so ending the
+// list with an AnyValue overload is a way to provide a default.
+//
+// The result type is that of the first overload; the others must return
+// something convertible to it.
+//
+
+namespace internal {
+
+//
+// KindsOf<T>::has(kind) says whether a value of that kind passes T's own
+// isValid() check.  This has to be kept in agreement with the isXXX()
+// functions in the bindings.  A class without a specialization can't be
+// used as a visitor parameter.
+//
+
+template <class T>
+struct KindsOf;
+
+template <Kind K>
+struct KindIs {
+    static constexpr bool has(Kind kind) { return kind == K; }
+};
+
+template <Kind First, Kind Last>
+struct KindRange {
+    static constexpr bool has(Kind kind) {
+        return kind >= First and kind <= Last;
+    }
+};
+
+template <>
+struct KindsOf<AnyValue> {
+    static constexpr bool has(Kind) { return true; }
+};
+
+template <> struct KindsOf<Atom> : KindRange<Kind::Unset, Kind::Tuple> {};
+template <> struct KindsOf<None> : KindIs<Kind::None> {};
+template <> struct KindsOf<Logic> : KindIs<Kind::Logic> {};
+template <> struct KindsOf<Character> : KindIs<Kind::Character> {};
+template <> struct KindsOf<Integer> : KindIs<Kind::Integer> {};
+template <> struct KindsOf<Float> : KindIs<Kind::Float> {};
+template <> struct KindsOf<Date> : KindIs<Kind::Date> {};
+template <> struct KindsOf<Time> : KindIs<Kind::Time> {};
+template <> struct KindsOf<Pair> : KindIs<Kind::Pair> {};
+template <> struct KindsOf<Tuple> : KindIs<Kind::Tuple> {};
+
+template <> struct KindsOf<AnyWord> : KindRange<Kind::Word, Kind::Issue> {};
+template <> struct KindsOf<Word> : KindIs<Kind::Word> {};
+template <> struct KindsOf<SetWord> : KindIs<Kind::SetWord> {};
+template <> struct KindsOf<GetWord> : KindIs<Kind::GetWord> {};
+template <> struct KindsOf<LitWord> : KindIs<Kind::LitWord> {};
+template <> struct KindsOf<Refinement> : KindIs<Kind::Refinement> {};
+
+template <> struct KindsOf<Series> : KindRange<Kind::Block, Kind::OtherString> {};
+
+template <> struct KindsOf<AnyArray> : KindRange<Kind::Block, Kind::LitPath> {};
+template <> struct KindsOf<Block> : KindIs<Kind::Block> {};
+template <> struct KindsOf<Group> : KindIs<Kind::Group> {};
+template <> struct KindsOf<Path> : KindIs<Kind::Path> {};
+template <> struct KindsOf<SetPath> : KindIs<Kind::SetPath> {};
+template <> struct KindsOf<GetPath> : KindIs<Kind::GetPath> {};
+template <> struct KindsOf<LitPath> : KindIs<Kind::LitPath> {};
+
+template <> struct KindsOf<AnyString> : KindRange<Kind::String, Kind::OtherString> {};
+template <> struct KindsOf<String> : KindIs<Kind::String> {};
+template <> struct KindsOf<Tag> : KindIs<Kind::Tag> {};
+template <> struct KindsOf<Filename> : KindIs<Kind::Filename> {};
+
+template <> struct KindsOf<Function> : KindIs<Kind::Function> {};
+template <> struct KindsOf<Context> : KindIs<Kind::Context> {};
+template <> struct KindsOf<Error> : KindIs<Kind::Error> {};
+template <> struct KindsOf<Image> : KindIs<Kind::Image> {};
+
+
+template <class F>
+using VisitParameter = typename std::decay<
+    typename utility::function_traits<F>::template arg<0>
+>::type;
+
+
+// Index of the first overload accepting kind K, or the number of overloads
+// if there is none.
+
+template <Kind K, std::size_t I, class... Fs>
+struct FirstAccepting {
+    static constexpr std::size_t value = I;
+};
+
+template <Kind K, std::size_t I, class F, class... Fs>
+struct FirstAccepting<K, I, F, Fs...> {
+    static constexpr std::size_t value =
+        KindsOf<VisitParameter<F>>::has(K)
+            ? I
+            : FirstAccepting<K, I + 1, Fs...>::value;
+};
+
+
+template <class R, class... Fs>
+class VisitTable {
+private:
+    using Overloads = std::tuple<Fs &&...>;
+    using Thunk = R (*)(AnyValue const &, Overloads &);
+
+    template <std::size_t I>
+    static R call(AnyValue const & value, Overloads & overloads) {
+        using F = typename utility::type_at<I, Fs...>::type;
+        using T = VisitParameter<F>;
+
+        static_assert(
+            std::is_base_of<AnyValue, T>::value,
+            "Visitor parameters must be ren:: value classes"
+        );
+
+        // A T made on the same cell, borrowed as the value keeps it alive
+        // for the call; an overload that keeps a copy gets a tracked one
+        return std::forward<F>(std::get<I>(overloads))(
+            AnyValue::borrowCell_<T>(value.cell, value.origin)
+        );
+    }
+
+    static R unmatched(AnyValue const & value, Overloads &) {
+        throw bad_value_cast(
+            "No overload in ren::visit() accepts " + to_string(value)
+        );
+    }
+
+    template <std::size_t I>
+    static constexpr Thunk thunk(std::true_type) {
+        return &call<I>;
+    }
+
+    template <std::size_t I>
+    static constexpr Thunk thunk(std::false_type) {
+        return &unmatched;
+    }
+
+    template <std::size_t K>
+    static constexpr Thunk thunkFor() {
+        using Index = FirstAccepting<static_cast<Kind>(K), 0, Fs...>;
+        return thunk<Index::value>(
+            std::integral_constant<bool, (Index::value < sizeof...(Fs))>{}
+        );
+    }
+
+    template <std::size_t... Ks>
+    static Thunk lookup(Kind kind, utility::indices<Ks...>) {
+        static constexpr Thunk table[] = {thunkFor<Ks>()...};
+        return table[static_cast<std::size_t>(kind)];
+    }
+
+public:
+    static R apply(AnyValue const & value, Fs &&... fs) {
+        Overloads overloads (std::forward<Fs>(fs)...);
+        return lookup(
+            value.kindOf_(),
+            utility::make_indices<static_cast<std::size_t>(Kind::Max)>{}
+        )(value, overloads);
+    }
+};
+
+} // end namespace internal
+
+
+template <class F, class... Fs>
+auto visit(AnyValue const & value, F && f, Fs &&... fs)
+    -> typename utility::function_traits<F>::result_type
+{
+    using R = typename utility::function_traits<F>::result_type;
+
+    return internal::VisitTable<R, F, Fs...>::apply(
+        value, std::forward<F>(f), std::forward<Fs>(fs)...
+    );
+}
+
+} // end namespace ren
+
+#endif
@@ -16,22 +16,130 @@
 // See http://rencpp.hostilefork.com for more information on this project
 //
 
+#include <algorithm>
+
 #include "rencpp/engine.hpp"
 #include "rencpp/ren.hpp"
 
 
 namespace ren {
 
+namespace internal {
+
+OutputBuffer::OutputBuffer (std::ostream & target) :
+    target (&target),
+    policy (),
+    lastFlush (std::chrono::steady_clock::now())
+{
+    setPolicy(policy);
+}
+
+
+void OutputBuffer::setTarget(std::ostream & newTarget) {
+    flush();
+    target = &newTarget;
+}
+
+
+void OutputBuffer::setPolicy(OutputPolicy const & newPolicy) {
+    flush();
+    policy = newPolicy;
+
+    // A threshold of zero still needs room for the character overflow()
+    // is handed, which is passed on straight away
+    buffer.resize(std::max<size_t>(policy.flushThreshold, 1));
+    setp(buffer.data(), buffer.data() + policy.flushThreshold);
+}
+
+
+bool OutputBuffer::passOn() {
+    auto pending = pptr() - pbase();
+    if (pending > 0)
+        target->write(pbase(), pending);
+    target->flush();
+
+    setp(buffer.data(), buffer.data() + policy.flushThreshold);
+    lastFlush = std::chrono::steady_clock::now();
+
+    return static_cast<bool>(*target);
+}
+
+
+bool OutputBuffer::flush() {
+    if (pptr() == pbase())
+        return true;
+    return passOn();
+}
+
+
+OutputBuffer::int_type OutputBuffer::overflow(int_type ch) {
+    if (not passOn())
+        return traits_type::eof();
+
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+        return traits_type::not_eof(ch);
+
+    if (policy.flushThreshold == 0) {
+        target->put(traits_type::to_char_type(ch));
+        target->flush();
+    }
+    else
+        sputc(traits_type::to_char_type(ch));
+
+    return *target ? ch : traits_type::eof();
+}
+
+
+std::streamsize OutputBuffer::xsputn(
+    char const * data,
+    std::streamsize count
+) {
+    auto room = epptr() - pptr();
+
+    if (count <= room) {
+        traits_type::copy(pptr(), data, static_cast<size_t>(count));
+        pbump(static_cast<int>(count));
+    }
+    else {
+        // Doesn't fit, so what's pending goes and then this goes around
+        // the buffer
+        if (not passOn())
+            return 0;
+        target->write(data, count);
+        target->flush();
+    }
+
+    if (std::chrono::steady_clock::now() - lastFlush >= policy.flushInterval)
+        if (not passOn())
+            return 0;
+
+    return *target ? count : 0;
+}
+
+
+int OutputBuffer::sync() {
+    return passOn() ? 0 : -1;
+}
+
+} // end namespace internal
+
+
 Engine::Finder Engine::finder;
 
 
 std::ostream & Engine::setOutputStream(std::ostream & os) {
     auto temp = osPtr;
     osPtr = &os;
+    outputBuffer.setTarget(os);
     return *temp;
 }
 
 
+void Engine::setOutputPolicy(OutputPolicy const & policy) {
+    outputBuffer.setPolicy(policy);
+}
+
+
 std::istream & Engine::setInputStream(std::istream & is) {
     auto temp = isPtr;
     isPtr = &is;
@@ -0,0 +1,174 @@
+//
+// evaluator.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <stdexcept>
+
+#include "rencpp/ren.hpp"
+#include "rencpp/evaluator.hpp"
+
+
+namespace ren {
+
+#ifdef REN_RUNTIME
+
+static std::atomic<bool> evaluatorExists {false};
+
+
+// How many waiting jobs deep others can be run nested; a job that waits at
+// this depth doesn't run any, so the evaluator's stack stays bounded
+
+static int const nestingLimit = 4;
+
+
+Evaluator::Evaluator () :
+    incoming (nullptr),
+    queued (nullptr),
+    nesting (0),
+    stopping (false),
+    drainNested ([this]() { drain(); }),
+    home (std::make_shared<internal::WhatHome>())
+{
+    if (evaluatorExists.exchange(true))
+        throw std::runtime_error("Only one ren::Evaluator may exist at a time");
+
+    home->run = [this](std::function<void()> const & format) {
+        post([&format]() { format(); }).get();
+    };
+
+    thread = std::thread {&Evaluator::serve, this};
+}
+
+
+void Evaluator::push(Job * job) {
+    Job * head = incoming.load(std::memory_order_relaxed);
+    do {
+        job->next = head;
+    } while (
+        not incoming.compare_exchange_weak(
+            head, job, std::memory_order_release, std::memory_order_relaxed
+        )
+    );
+
+    // Only a push onto an empty list can find the evaluator asleep; later
+    // ones know it has been (or is being) woken
+    if (head == nullptr) {
+        std::lock_guard<std::mutex> lock {sleepMutex};
+        wakeup.notify_one();
+    }
+}
+
+
+// Jobs are only taken from incoming once the queue is empty, so one run
+// nested in a waiting job can't get ahead of an older one
+
+bool Evaluator::runNext() {
+    if (queued == nullptr) {
+        Job * batch = incoming.exchange(nullptr, std::memory_order_acquire);
+        if (batch == nullptr)
+            return false;
+
+        // The list is most recent first; turn it around to run in order
+        while (batch) {
+            Job * next = batch->next;
+            batch->next = queued;
+            queued = batch;
+            batch = next;
+        }
+    }
+
+    Job * job = queued;
+    queued = job->next;
+
+    job->run(); // packaged_task keeps any exception for the future
+    delete job;
+    return true;
+}
+
+
+void Evaluator::drain() {
+    if (nesting == nestingLimit)
+        return;
+
+    ++nesting;
+    while (runNext())
+        continue;
+    --nesting;
+}
+
+
+void Evaluator::serve() {
+    internal::whileAwaitingFuture = &drainNested;
+
+    // Set before any job runs, so every exception made here can find it
+    home->thread = std::this_thread::get_id();
+    internal::whatHome = home;
+
+    while (true) {
+        if (runNext())
+            continue;
+
+        std::unique_lock<std::mutex> lock {sleepMutex};
+        wakeup.wait(lock, [this]() {
+            return stopping or incoming.load() != nullptr;
+        });
+
+        if (stopping and incoming.load() == nullptr)
+            break;
+    }
+
+    internal::whileAwaitingFuture = nullptr;
+    internal::whatHome = nullptr;
+}
+
+
+std::future<optional<AnyValue>> Evaluator::submit(std::string source) {
+    return post([source]() {
+        return runtime(source.c_str());
+    });
+}
+
+
+std::future<optional<AnyValue>> Evaluator::submit(Block code) {
+    return post([code]() {
+        return runtime("do", code);
+    });
+}
+
+
+Evaluator::~Evaluator () {
+    // No more what() can be made once the thread has gone; one that is
+    // being made is waited for
+    {
+        std::lock_guard<std::mutex> lock {home->mutex};
+        home->run = nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock {sleepMutex};
+        stopping = true;
+    }
+    wakeup.notify_one();
+
+    thread.join();
+
+    evaluatorExists.store(false);
+}
+
+#endif
+
+} // end namespace ren
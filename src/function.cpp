@@ -17,6 +17,10 @@
 // See http://rencpp.hostilefork.com for more information on this project
 //
 
+#include <map>
+#include <stdexcept>
+#include <string>
+
 #include "rencpp/value.hpp"
 #include "rencpp/function.hpp"
 
@@ -27,9 +31,66 @@ namespace ren {
 namespace internal {
     std::mutex extensionTablesMutex;
 
-    RenShimId shimIdToCapture = -1;
+    std::atomic<RenShimId> * shimIdToCapture = nullptr;
+
+    std::atomic<RenShimBouncer> * shimBouncerToCapture = nullptr;
+
+    thread_local std::function<void()> const * whileAwaitingFuture = nullptr;
+
+
+    struct ShimRegistration {
+        RenShimReleaser releaser;
+        RenShimId id;
+    };
+
+    static std::map<RenShimPointer, ShimRegistration> shimRegistrations;
+
+    void noteShimRegistration(
+        RenShimPointer shim, RenShimReleaser releaser, RenShimId id
+    ) {
+        shimRegistrations[shim] = ShimRegistration {releaser, id};
+    }
+
+
+    // Same rule as specArity(): the words (plain, lit, and get) and the
+    // refinements at the top level each take a slot in the frame
+    void checkSpecArity(Block const & spec, std::size_t arity) {
+        std::size_t count = 0;
+        for (auto item : spec) {
+            if (
+                item.isWord() or item.isLitWord() or item.isGetWord()
+                or item.isRefinement()
+            ) {
+                ++count;
+            }
+        }
+
+        if (count != arity)
+            throw std::invalid_argument(
+                "ren::Function spec block takes " + std::to_string(count)
+                + " arguments, but the C++ signature has "
+                + std::to_string(arity)
+            );
+    }
+}
+
+
+bool Function::release() {
+    RenShimPointer shim = getShim();
+    if (not shim)
+        return false;
+
+    std::lock_guard<std::mutex> lock {internal::extensionTablesMutex};
+
+    auto it = internal::shimRegistrations.find(shim);
+    if (it == internal::shimRegistrations.end())
+        return false; // direct native, or already released
+
+    if (not it->second.releaser(it->second.id))
+        return false;
 
-    RenShimBouncer shimBouncerToCapture = nullptr;
+    internal::shimRegistrations.erase(it);
+    return true;
 }
 
 #endif
@@ -0,0 +1,257 @@
+//
+// image.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <cstring>
+
+#include "rencpp/image.hpp"
+
+#if defined(__SSE2__) or defined(_M_X64)
+    #include <emmintrin.h>
+    #define REN_PIXELS_SSE2
+#endif
+
+#if defined(__SSSE3__)
+    #include <tmmintrin.h>
+    #define REN_PIXELS_SSSE3
+#endif
+
+
+namespace ren {
+
+//
+// PIXEL FORMAT CONVERSION
+//
+
+//
+// All the formats have alpha in the fourth byte, so a conversion is at most
+// a swap of the first and third bytes and a change of premultiplication.
+// The scalar loops do any pixels the vector ones leave over.
+//
+// Premultiplying rounds c * a / 255 to nearest, computed as
+// (t + (t >> 8)) >> 8 with t = c * a + 128, which is exact for bytes.
+//
+
+namespace {
+
+bool isSwapped(PixelFormat format) {
+    return format == PixelFormat::BGRA8
+        or format == PixelFormat::BGRA8Premultiplied;
+}
+
+bool isPremultiplied(PixelFormat format) {
+    return format == PixelFormat::RGBA8Premultiplied
+        or format == PixelFormat::BGRA8Premultiplied;
+}
+
+
+inline unsigned char multiplyByAlpha(unsigned int c, unsigned int a) {
+    unsigned int t = c * a + 128;
+    return static_cast<unsigned char>((t + (t >> 8)) >> 8);
+}
+
+inline unsigned char divideByAlpha(unsigned int c, unsigned int a) {
+    if (a == 0)
+        return 0;
+    unsigned int result = (c * 255 + a / 2) / a;
+    return static_cast<unsigned char>(result > 255 ? 255 : result);
+}
+
+
+void swapScalar(
+    unsigned char const * from, unsigned char * to, size_t count
+) {
+    for (size_t index = 0; index < count; ++index, from += 4, to += 4) {
+        unsigned char first = from[0];
+        to[0] = from[2];
+        to[1] = from[1];
+        to[2] = first;
+        to[3] = from[3];
+    }
+}
+
+
+void premultiplyScalar(
+    unsigned char const * from, unsigned char * to, size_t count, bool swap
+) {
+    for (size_t index = 0; index < count; ++index, from += 4, to += 4) {
+        unsigned int a = from[3];
+        unsigned char first = multiplyByAlpha(from[0], a);
+        unsigned char third = multiplyByAlpha(from[2], a);
+        to[0] = swap ? third : first;
+        to[1] = multiplyByAlpha(from[1], a);
+        to[2] = swap ? first : third;
+        to[3] = static_cast<unsigned char>(a);
+    }
+}
+
+
+void unpremultiplyScalar(
+    unsigned char const * from, unsigned char * to, size_t count, bool swap
+) {
+    for (size_t index = 0; index < count; ++index, from += 4, to += 4) {
+        unsigned int a = from[3];
+        unsigned char first = divideByAlpha(from[0], a);
+        unsigned char third = divideByAlpha(from[2], a);
+        to[0] = swap ? third : first;
+        to[1] = divideByAlpha(from[1], a);
+        to[2] = swap ? first : third;
+        to[3] = static_cast<unsigned char>(a);
+    }
+}
+
+
+#ifdef REN_PIXELS_SSE2
+
+// Two pixels widened to 16-bit lanes, with the first and third swapped
+
+inline __m128i swapWide(__m128i wide) {
+    wide = _mm_shufflelo_epi16(wide, _MM_SHUFFLE(3, 0, 1, 2));
+    return _mm_shufflehi_epi16(wide, _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+
+// Two pixels widened to 16-bit lanes, premultiplied (alpha is left alone,
+// by multiplying it by 255)
+
+inline __m128i premultiplyWide(__m128i wide) {
+    __m128i const alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    __m128i const opaque = _mm_set1_epi16(255);
+    __m128i const half = _mm_set1_epi16(128);
+
+    __m128i alpha = _mm_shufflelo_epi16(wide, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_or_si128(
+        _mm_andnot_si128(alphaLanes, alpha),
+        _mm_and_si128(alphaLanes, opaque)
+    );
+
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(wide, alpha), half);
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+
+size_t premultiplySSE2(
+    unsigned char const * from, unsigned char * to, size_t count, bool swap
+) {
+    __m128i const zero = _mm_setzero_si128();
+
+    size_t done = 0;
+    for (; done + 4 <= count; done += 4, from += 16, to += 16) {
+        __m128i pixels = _mm_loadu_si128(
+            reinterpret_cast<__m128i const *>(from)
+        );
+
+        __m128i low = premultiplyWide(_mm_unpacklo_epi8(pixels, zero));
+        __m128i high = premultiplyWide(_mm_unpackhi_epi8(pixels, zero));
+        if (swap) {
+            low = swapWide(low);
+            high = swapWide(high);
+        }
+
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(to), _mm_packus_epi16(low, high)
+        );
+    }
+    return done;
+}
+
+
+size_t swapSSE2(unsigned char const * from, unsigned char * to, size_t count) {
+    size_t done = 0;
+
+#ifdef REN_PIXELS_SSSE3
+    __m128i const order = _mm_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+    );
+    for (; done + 4 <= count; done += 4, from += 16, to += 16) {
+        __m128i pixels = _mm_loadu_si128(
+            reinterpret_cast<__m128i const *>(from)
+        );
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(to), _mm_shuffle_epi8(pixels, order)
+        );
+    }
+#else
+    __m128i const zero = _mm_setzero_si128();
+    for (; done + 4 <= count; done += 4, from += 16, to += 16) {
+        __m128i pixels = _mm_loadu_si128(
+            reinterpret_cast<__m128i const *>(from)
+        );
+        __m128i low = swapWide(_mm_unpacklo_epi8(pixels, zero));
+        __m128i high = swapWide(_mm_unpackhi_epi8(pixels, zero));
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(to), _mm_packus_epi16(low, high)
+        );
+    }
+#endif
+
+    return done;
+}
+
+#endif
+
+} // end anonymous namespace
+
+
+void convertPixels(
+    void const * from,
+    PixelFormat fromFormat,
+    void * to,
+    PixelFormat toFormat,
+    size_t count
+) {
+    auto source = static_cast<unsigned char const *>(from);
+    auto dest = static_cast<unsigned char *>(to);
+
+    bool swap = isSwapped(fromFormat) != isSwapped(toFormat);
+    bool premultiply = isPremultiplied(toFormat)
+        and not isPremultiplied(fromFormat);
+    bool unpremultiply = isPremultiplied(fromFormat)
+        and not isPremultiplied(toFormat);
+
+    if (unpremultiply) {
+        // A divide per channel, which SSE2 has no integer instruction for
+        unpremultiplyScalar(source, dest, count, swap);
+        return;
+    }
+
+    size_t done = 0;
+
+    if (premultiply) {
+    #ifdef REN_PIXELS_SSE2
+        done = premultiplySSE2(source, dest, count, swap);
+    #endif
+        premultiplyScalar(
+            source + 4 * done, dest + 4 * done, count - done, swap
+        );
+        return;
+    }
+
+    if (swap) {
+    #ifdef REN_PIXELS_SSE2
+        done = swapSSE2(source, dest, count);
+    #endif
+        swapScalar(source + 4 * done, dest + 4 * done, count - done);
+        return;
+    }
+
+    if (source != dest)
+        std::memmove(dest, source, 4 * count);
+}
+
+} // end namespace ren
@@ -0,0 +1,113 @@
+//
+// input.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "rencpp/input.hpp"
+
+
+namespace ren {
+
+static size_t roundUpToPowerOfTwo(size_t size) {
+    size_t result = 1;
+    while (result < size)
+        result <<= 1;
+    return result;
+}
+
+
+InputRing::InputRing (size_t capacity) :
+    mask (roundUpToPowerOfTwo(std::max<size_t>(capacity, 1)) - 1),
+    head (0),
+    tail (0),
+    closed (false),
+    readerWaiting (false)
+{
+    data.reset(new char[mask + 1]);
+}
+
+
+void InputRing::wakeReader() {
+    // Pairs with the store in waitReadable(); with both sequentially
+    // consistent, either the reader sees the new tail or we see it waiting
+    if (readerWaiting.load()) {
+        std::lock_guard<std::mutex> lock {sleepMutex};
+        wakeup.notify_one();
+    }
+}
+
+
+size_t InputRing::write(char const * bytes, size_t size) {
+    size_t const end = tail.load(std::memory_order_relaxed);
+    size_t const room = capacity() - (end - head.load(std::memory_order_acquire));
+
+    size = std::min(size, room);
+    if (size == 0)
+        return 0;
+
+    // Up to two pieces, if the space wraps around the end
+    size_t const start = end & mask;
+    size_t const first = std::min(size, capacity() - start);
+    std::memcpy(data.get() + start, bytes, first);
+    std::memcpy(data.get(), bytes + first, size - first);
+
+    tail.store(end + size);
+    wakeReader();
+
+    return size;
+}
+
+
+void InputRing::close() {
+    closed.store(true);
+    wakeReader();
+}
+
+
+size_t InputRing::read(char * bytes, size_t size) {
+    size_t const start = head.load(std::memory_order_relaxed);
+    size = std::min(size, tail.load(std::memory_order_acquire) - start);
+    if (size == 0)
+        return 0;
+
+    size_t const index = start & mask;
+    size_t const first = std::min(size, capacity() - index);
+    std::memcpy(bytes, data.get() + index, first);
+    std::memcpy(bytes + first, data.get(), size - first);
+
+    head.store(start + size, std::memory_order_release);
+
+    return size;
+}
+
+
+bool InputRing::waitReadable(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock {sleepMutex};
+
+    readerWaiting.store(true);
+    bool ready = wakeup.wait_for(lock, timeout, [this]() {
+        return tail.load() != head.load(std::memory_order_relaxed)
+            or closed.load();
+    });
+    readerWaiting.store(false);
+
+    return ready;
+}
+
+} // end namespace ren
@@ -0,0 +1,293 @@
+//
+// loader.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <cerrno>
+#include <stdexcept>
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+#include "rencpp/ren.hpp"
+#include "rencpp/loader.hpp"
+
+
+namespace ren {
+
+namespace internal {
+
+static bool isSpace(char ch) {
+    return ch == ' ' or ch == '\t' or ch == '\r' or ch == '\n';
+}
+
+
+ValueSplitter::ValueSplitter (bool unwrap) :
+    mode (Mode::Normal),
+    escaped (false),
+    braceDepth (0),
+    depth (0),
+    unwrap (unwrap),
+    base (0),
+    started (false),
+    wrapperClosed (false),
+    problem (nullptr)
+{
+}
+
+
+void ValueSplitter::emit(std::vector<std::string> & out) {
+    if (pending.empty())
+        return;
+
+    out.push_back(std::move(pending));
+    pending.clear();
+}
+
+
+void ValueSplitter::feed(
+    char const * data,
+    size_t size,
+    std::vector<std::string> & out
+) {
+    if (problem)
+        return;
+
+    for (size_t index = 0; index < size; ++index) {
+        char ch = data[index];
+
+        switch (mode) {
+        case Mode::Comment:
+            if (ch == '\n')
+                mode = Mode::Normal;
+            continue;
+
+        case Mode::Quoted:
+            pending += ch;
+            if (escaped)
+                escaped = false;
+            else if (ch == '^')
+                escaped = true;
+            else if (ch == '"')
+                mode = Mode::Normal;
+            continue;
+
+        case Mode::Braced:
+            pending += ch;
+            if (escaped)
+                escaped = false;
+            else if (ch == '^')
+                escaped = true;
+            else if (ch == '{')
+                ++braceDepth;
+            else if (ch == '}' and --braceDepth == 0)
+                mode = Mode::Normal;
+            continue;
+
+        case Mode::Normal:
+        default:
+            break;
+        }
+
+        if (isSpace(ch)) {
+            if (depth == base)
+                emit(out);
+            else
+                pending += ch;
+            continue;
+        }
+
+        if (ch == ';') {
+            // A comment ends a value, and inside a block it still has to
+            // separate what's on either side of it
+            if (depth == base)
+                emit(out);
+            else
+                pending += ' ';
+            mode = Mode::Comment;
+            continue;
+        }
+
+        // Only whitespace and comments can come before the wrapping block,
+        // else there isn't one; and only those can come after it
+        bool first = not started;
+        started = true;
+
+        if (wrapperClosed) {
+            problem = "text after the block that wraps the stream";
+            pending.clear();
+            return;
+        }
+
+        switch (ch) {
+        case '"':
+            mode = Mode::Quoted;
+            break;
+
+        case '{':
+            mode = Mode::Braced;
+            braceDepth = 1;
+            break;
+
+        case '[':
+        case '(':
+            if (unwrap and first and ch == '[') {
+                base = depth = 1;
+                continue;
+            }
+
+            // Adjacent blocks, as in `[1][2]`, are two values; other
+            // things before an opening bracket may belong with it
+            if (
+                depth == base
+                and not pending.empty()
+                and (pending.back() == ']' or pending.back() == ')')
+            ) {
+                emit(out);
+            }
+            ++depth;
+            break;
+
+        case ']':
+        case ')':
+            if (depth == 1 and base == 1 and ch == ']') {
+                // The end of the wrapping block
+                emit(out);
+                base = depth = 0;
+                wrapperClosed = true;
+                continue;
+            }
+            if (depth > 0)
+                --depth;
+            break;
+
+        default:
+            break;
+        }
+
+        pending += ch;
+    }
+}
+
+
+void ValueSplitter::finish(std::vector<std::string> & out) {
+    // Whatever is left (even if unterminated) goes to be loaded, and the
+    // load reports what's wrong with it
+    emit(out);
+
+    if (base == 1 and not problem)
+        problem = "the block that wraps the stream isn't closed";
+}
+
+} // end namespace internal
+
+
+
+StreamLoader::StreamLoader (
+    std::istream & input,
+    bool unwrap,
+    size_t chunkSize
+) :
+    input (&input),
+    fd (-1),
+    chunk (chunkSize),
+    exhausted (false),
+    splitter (unwrap),
+    nextText (0)
+{
+}
+
+
+#ifndef _WIN32
+
+StreamLoader::StreamLoader (int fd, bool unwrap, size_t chunkSize) :
+    input (nullptr),
+    fd (fd),
+    chunk (chunkSize),
+    exhausted (false),
+    splitter (unwrap),
+    nextText (0)
+{
+}
+
+#endif
+
+
+size_t StreamLoader::readChunk() {
+    if (input) {
+        input->read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        if (input->bad())
+            throw std::runtime_error("StreamLoader couldn't read its stream");
+        return static_cast<size_t>(input->gcount());
+    }
+
+#ifdef _WIN32
+    return 0;
+#else
+    while (true) {
+        auto count = ::read(fd, chunk.data(), chunk.size());
+        if (count >= 0)
+            return static_cast<size_t>(count);
+        if (errno != EINTR)
+            throw std::runtime_error("StreamLoader couldn't read its file");
+    }
+#endif
+}
+
+
+optional<AnyValue> StreamLoader::next() {
+    while (values.empty()) {
+        if (nextText == texts.size()) {
+            texts.clear();
+            nextText = 0;
+
+            // Whatever came before a mistake in the text is given out first
+            if (splitter.malformed())
+                throw load_error {Error {splitter.malformed()}};
+
+            if (exhausted)
+                return nullopt;
+
+            size_t count = readChunk();
+            if (count == 0) {
+                exhausted = true;
+                splitter.finish(texts);
+            }
+            else
+                splitter.feed(chunk.data(), count, texts);
+            continue;
+        }
+
+        // Texts are loaded one at a time so a bad one doesn't lose the ones
+        // that came before it
+        std::string text = std::move(texts[nextText++]);
+
+        // A std::string has a NUL after its data, so it's scanned in place
+        Block loaded = Runtime::loadUtf8(
+            text.data(), text.size(), context ? &*context : nullptr,
+            nullptr, true
+        );
+        for (auto value : loaded)
+            values.push_back(value);
+    }
+
+    AnyValue value = std::move(values.front());
+    values.pop_front();
+    return value;
+}
+
+} // end namespace ren
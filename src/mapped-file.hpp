@@ -0,0 +1,152 @@
+#ifndef RENCPP_MAPPED_FILE_HPP
+#define RENCPP_MAPPED_FILE_HPP
+
+//
+// mapped-file.hpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+//
+// Internal support for memory-mapping a file read-only, for the in-memory
+// file mounts (see memfs.hpp).  Where there's no mmap the file is read into
+// memory instead.  This is not an installed header.
+//
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+    #include <fstream>
+    #include <iterator>
+    #include <vector>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+namespace ren {
+
+namespace internal {
+
+class MappedFile {
+private:
+    void const * address;
+    size_t length;
+    size_t mappedLength;
+
+#ifdef _WIN32
+    std::vector<char> contents;
+#endif
+
+public:
+    // If terminated, there is a zero byte just past the end of the data (for
+    // code that would otherwise stop only on a NUL), without copying it
+    explicit MappedFile (std::string const & path, bool terminated = false) :
+        address (nullptr),
+        length (0),
+        mappedLength (0)
+    {
+#ifdef _WIN32
+        std::ifstream file {path, std::ios::binary};
+        if (not file)
+            throw std::runtime_error("Couldn't open " + path + " to map");
+
+        contents.assign(
+            std::istreambuf_iterator<char> {file},
+            std::istreambuf_iterator<char> {}
+        );
+        length = contents.size();
+        if (terminated)
+            contents.push_back('\0');
+        address = contents.data();
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Couldn't open " + path + " to map");
+
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Couldn't get the size of " + path);
+        }
+        length = static_cast<size_t>(info.st_size);
+        mappedLength = length;
+
+        // The rest of the last page of a mapping reads as zeros, so only a
+        // file that ends on a page boundary needs one more page.  That page
+        // is reserved first (as anonymous zeros), and the file mapped over
+        // the start of it.
+        auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        bool extraPage = terminated and length % page == 0;
+        if (extraPage)
+            mappedLength += page;
+
+        void * mapped = nullptr;
+        if (extraPage) {
+            mapped = mmap(
+                nullptr, mappedLength, PROT_READ,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+            );
+            if (mapped != MAP_FAILED and length > 0) {
+                void * file = mmap(
+                    mapped, length, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0
+                );
+                if (file == MAP_FAILED) {
+                    munmap(mapped, mappedLength);
+                    mapped = MAP_FAILED;
+                }
+            }
+        }
+        else if (length > 0) // mmap() won't map nothing
+            mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // The mapping stays good without the descriptor
+        ::close(fd);
+
+        if (mapped == MAP_FAILED)
+            throw std::runtime_error("Couldn't map " + path);
+        address = mapped;
+#endif
+    }
+
+    MappedFile (MappedFile const &) = delete;
+    MappedFile & operator= (MappedFile const &) = delete;
+
+    char const * data() const noexcept {
+        return static_cast<char const *>(address);
+    }
+
+    size_t size() const noexcept {
+        return length;
+    }
+
+    ~MappedFile () {
+#ifndef _WIN32
+        if (address)
+            munmap(const_cast<void *>(address), mappedLength);
+#endif
+    }
+};
+
+} // end namespace internal
+
+} // end namespace ren
+
+#endif
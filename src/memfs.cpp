@@ -0,0 +1,265 @@
+//
+// memfs.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "rencpp/memfs.hpp"
+
+#include "mapped-file.hpp"
+
+
+namespace ren {
+
+void MemoryFiles::add(std::string const & name, std::vector<char> bytes) {
+    File file;
+    file.writable = true;
+    file.bytes = std::move(bytes);
+    file.view = nullptr;
+    file.viewSize = 0;
+
+    std::lock_guard<std::mutex> lock {mutex};
+    files[name] = std::move(file);
+}
+
+
+void MemoryFiles::addView(
+    std::string const & name,
+    void const * data,
+    size_t size
+) {
+    File file;
+    file.writable = false;
+    file.view = static_cast<char const *>(data);
+    file.viewSize = size;
+
+    std::lock_guard<std::mutex> lock {mutex};
+    files[name] = std::move(file);
+}
+
+
+void MemoryFiles::addMapped(
+    std::string const & name,
+    std::string const & hostPath
+) {
+    auto mapped = std::make_shared<internal::MappedFile>(hostPath);
+
+    File file;
+    file.writable = false;
+    file.view = mapped->data();
+    file.viewSize = mapped->size();
+    file.owner = mapped;
+
+    std::lock_guard<std::mutex> lock {mutex};
+    files[name] = std::move(file);
+}
+
+
+bool MemoryFiles::remove(std::string const & name) {
+    std::lock_guard<std::mutex> lock {mutex};
+    return files.erase(name) > 0;
+}
+
+
+optional<std::vector<char>> MemoryFiles::get(std::string const & name) const {
+    std::lock_guard<std::mutex> lock {mutex};
+
+    auto it = files.find(name);
+    if (it == files.end())
+        return nullopt;
+
+    return std::vector<char> {
+        it->second.data(), it->second.data() + it->second.size()
+    };
+}
+
+
+std::vector<std::string> MemoryFiles::names() const {
+    std::lock_guard<std::mutex> lock {mutex};
+
+    std::vector<std::string> result;
+    for (auto const & entry : files)
+        result.push_back(entry.first);
+    return result;
+}
+
+
+bool MemoryFiles::query(std::string const & name, uint64_t * sizeOut) const {
+    std::lock_guard<std::mutex> lock {mutex};
+
+    auto it = files.find(name);
+    if (it == files.end())
+        return false;
+
+    *sizeOut = it->second.size();
+    return true;
+}
+
+
+bool MemoryFiles::open(std::string const & name, bool write, bool truncate) {
+    std::lock_guard<std::mutex> lock {mutex};
+
+    auto it = files.find(name);
+    if (it == files.end()) {
+        if (not write)
+            return false;
+
+        File file;
+        file.writable = true;
+        file.view = nullptr;
+        file.viewSize = 0;
+        files[name] = std::move(file);
+        return true;
+    }
+
+    if (not write)
+        return true;
+
+    if (not it->second.writable)
+        return false;
+
+    if (truncate)
+        it->second.bytes.clear();
+    return true;
+}
+
+
+size_t MemoryFiles::read(
+    std::string const & name,
+    uint64_t offset,
+    char * out,
+    size_t size
+) const {
+    std::lock_guard<std::mutex> lock {mutex};
+
+    auto it = files.find(name);
+    if (it == files.end() or offset >= it->second.size())
+        return 0;
+
+    size = std::min<size_t>(size, it->second.size() - offset);
+    std::memcpy(out, it->second.data() + offset, size);
+    return size;
+}
+
+
+bool MemoryFiles::write(
+    std::string const & name,
+    uint64_t offset,
+    char const * bytes,
+    size_t size
+) {
+    std::lock_guard<std::mutex> lock {mutex};
+
+    auto it = files.find(name);
+    if (it == files.end() or not it->second.writable)
+        return false;
+
+    auto & contents = it->second.bytes;
+    if (offset + size > contents.size())
+        contents.resize(offset + size);
+    std::copy(bytes, bytes + size, contents.begin() + static_cast<ptrdiff_t>(offset));
+    return true;
+}
+
+
+bool MemoryFiles::rename(std::string const & from, std::string const & to) {
+    std::lock_guard<std::mutex> lock {mutex};
+
+    auto it = files.find(from);
+    if (it == files.end())
+        return false;
+
+    File file = std::move(it->second);
+    files.erase(it);
+    files[to] = std::move(file);
+    return true;
+}
+
+
+
+//
+// MOUNTS
+//
+
+namespace {
+
+struct Mounts {
+    std::mutex mutex;
+
+    // Longest path first, so a mount inside another one is found before it
+    struct LongerFirst {
+        bool operator()(std::string const & a, std::string const & b) const {
+            return a.size() != b.size() ? a.size() > b.size() : a < b;
+        }
+    };
+    std::map<std::string, std::shared_ptr<MemoryFiles>, LongerFirst> byPath;
+};
+
+Mounts & mounts() {
+    static Mounts instance;
+    return instance;
+}
+
+void endWithSlash(std::string & path) {
+    if (path.empty() or path.back() != '/')
+        path += '/';
+}
+
+} // end anonymous namespace
+
+
+void mountFiles(std::string path, std::shared_ptr<MemoryFiles> files) {
+    endWithSlash(path);
+
+    auto & registry = mounts();
+    std::lock_guard<std::mutex> lock {registry.mutex};
+    registry.byPath[path] = std::move(files);
+}
+
+
+bool unmountFiles(std::string path) {
+    endWithSlash(path);
+
+    auto & registry = mounts();
+    std::lock_guard<std::mutex> lock {registry.mutex};
+    return registry.byPath.erase(path) > 0;
+}
+
+
+namespace internal {
+
+std::shared_ptr<MemoryFiles> findMountedFiles(
+    std::string const & path,
+    std::string * nameOut
+) {
+    auto & registry = mounts();
+    std::lock_guard<std::mutex> lock {registry.mutex};
+
+    for (auto const & mount : registry.byPath) {
+        auto const & prefix = mount.first;
+        if (path.compare(0, prefix.size(), prefix) == 0) {
+            *nameOut = path.substr(prefix.size());
+            return mount.second;
+        }
+    }
+    return nullptr;
+}
+
+} // end namespace internal
+
+} // end namespace ren
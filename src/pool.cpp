@@ -0,0 +1,379 @@
+//
+// pool.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include "rencpp/ren.hpp"
+#include "rencpp/pool.hpp"
+#include "rencpp/serialize.hpp"
+
+#if defined(REN_RUNTIME) and !defined(_WIN32)
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <csignal>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "spawner.hpp"
+
+
+namespace ren {
+
+//
+// Each evaluation is asked for with one frame whose first byte says what
+// follows: 'T' and source text, or 'B' and a block as serialize() writes
+// it.  The answer is one frame whose first byte is 'V' and the value (molded
+// for 'T', serialized for 'B'), 'U' for no value, or 'E' and the message of
+// whatever was thrown.
+//
+
+static std::string evaluateForReply(std::string const & request) {
+    try {
+        if (request.empty())
+            return "Eempty request";
+
+        if (request[0] == 'B') {
+            auto code = deserialize(string_view {request}.substr(1));
+            auto result = runtime("do", code);
+            if (result == nullopt)
+                return "U";
+            return "V" + serialize(*result);
+        }
+
+        auto result = runtime(request.c_str() + 1);
+        if (result == nullopt)
+            return "U";
+        return "V" + to_string(*runtime("mold/only", Block {*result}));
+    }
+    catch (std::exception const & e) {
+        return std::string {"E"} + e.what();
+    }
+}
+
+
+static optional<std::string> takeReply(std::string const & reply) {
+    switch (reply[0]) {
+    case 'V':
+        return reply.substr(1);
+
+    case 'U':
+        return nullopt;
+
+    default:
+        throw worker_error {reply.substr(1)};
+    }
+}
+
+
+static void serveEvaluations(int fd) {
+    std::string request;
+    while (internal::readFrame(fd, request))
+        if (not internal::writeFrame(fd, evaluateForReply(request)))
+            return;
+}
+
+
+static void serveOneEvaluation(int fd) {
+    std::string request;
+    if (internal::readFrame(fd, request))
+        internal::writeFrame(fd, evaluateForReply(request));
+}
+
+
+// Serializes the code and deserializes the result with the engine of the
+// calling thread, turning an error raised in the worker back into an
+// evaluation_error
+
+template <class Run>
+static optional<AnyValue> evaluateElsewhere(Block const & code, Run && run) {
+    optional<std::string> bytes;
+    try {
+        bytes = run("B" + serialize(code));
+    }
+    catch (worker_error const & e) {
+        throw evaluation_error {Error {e.what()}};
+    }
+
+    if (bytes == nullopt)
+        return nullopt;
+
+    return deserialize(string_view {*bytes});
+}
+
+
+// Waits for the worker to start answering, which is false only if the
+// deadline passes first; a socket that fails is left for readFrame to find
+
+static bool answersBy(
+    int fd, std::chrono::steady_clock::time_point deadline
+) {
+    using namespace std::chrono;
+
+    while (true) {
+        auto left = duration_cast<milliseconds>(deadline - steady_clock::now());
+        if (left.count() < 0)
+            return false;
+
+        pollfd entry;
+        entry.fd = fd;
+        entry.events = POLLIN;
+        entry.revents = 0;
+
+        // Rounded up, so a wakeup just short of the deadline doesn't spin
+        auto wait = std::min<milliseconds::rep>(left.count() + 1, INT_MAX);
+        int ready = poll(&entry, 1, static_cast<int>(wait));
+        if (ready > 0)
+            return true;
+        if (ready < 0 and errno != EINTR)
+            return true;
+    }
+}
+
+
+EnginePool::EnginePool (
+    size_t numWorkers,
+    size_t pendingLimit,
+    std::chrono::milliseconds timeout
+) :
+    maxPending (pendingLimit),
+    jobTimeout (timeout),
+    stopping (false),
+    restartCount (0)
+{
+    if (numWorkers == 0)
+        numWorkers = std::max(1u, std::thread::hardware_concurrency());
+    if (maxPending == 0)
+        maxPending = 4 * numWorkers;
+
+    // Get the runtime booted before the snapshot is taken, so the workers
+    // don't each have to do it
+    runtime("none");
+
+    spawner.reset(new internal::Spawner {&serveEvaluations});
+
+    try {
+        for (size_t index = 0; index < numWorkers; ++index) {
+            auto child = spawner->spawn();
+            workers.emplace_back(new Worker {std::thread {}, child.pid, child.fd});
+        }
+    }
+    catch (...) {
+        for (auto & worker : workers)
+            close(worker->fd);
+        throw;
+    }
+
+    for (auto & worker : workers)
+        worker->thread = std::thread {
+            &EnginePool::serve, this, std::ref(*worker)
+        };
+}
+
+
+std::future<optional<std::string>> EnginePool::submit(std::string source) {
+    return submitRequest("T" + source);
+}
+
+
+std::future<optional<std::string>> EnginePool::submitRequest(
+    std::string request
+) {
+    Job job;
+    job.request = std::move(request);
+    auto future = job.promise.get_future();
+
+    {
+        std::unique_lock<std::mutex> lock {mutex};
+        jobTaken.wait(lock, [this]() { return pending.size() < maxPending; });
+        pending.push_back(std::move(job));
+    }
+    jobAdded.notify_one();
+
+    return future;
+}
+
+
+optional<AnyValue> EnginePool::evaluate(Block const & code) {
+    return evaluateElsewhere(code, [this](std::string request) {
+        return submitRequest(std::move(request)).get();
+    });
+}
+
+
+void EnginePool::serve(Worker & worker) {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock {mutex};
+            jobAdded.wait(lock, [this]() {
+                return stopping or not pending.empty();
+            });
+            if (stopping)
+                return;
+
+            job = std::move(pending.front());
+            pending.pop_front();
+        }
+        jobTaken.notify_one();
+
+        // The worker's end of the socket only closes if it has died, or if
+        // it has been killed for running past the deadline
+        auto deadline = std::chrono::steady_clock::now() + jobTimeout;
+        bool timedOut = false;
+
+        std::string reply;
+        bool answered = worker.fd >= 0
+            and internal::writeFrame(worker.fd, job.request);
+
+        if (
+            answered
+            and jobTimeout.count() > 0
+            and not answersBy(worker.fd, deadline)
+        ) {
+            kill(worker.pid, SIGKILL);
+            timedOut = true;
+            answered = false;
+        }
+
+        if (
+            not answered
+            or not internal::readFrame(worker.fd, reply)
+            or reply.empty()
+        ) {
+            // Restarted before the job fails, so that whoever sees it fail
+            // also sees the restart counted
+            bool restarted = restart(worker);
+            job.promise.set_exception(
+                timedOut
+                    ? std::make_exception_ptr(worker_timeout {})
+                    : std::make_exception_ptr(worker_lost {})
+            );
+            if (not restarted)
+                return;
+            continue;
+        }
+
+        try {
+            job.promise.set_value(takeReply(reply));
+        }
+        catch (worker_error const &) {
+            job.promise.set_exception(std::current_exception());
+        }
+    }
+}
+
+
+bool EnginePool::restart(Worker & worker) {
+    std::lock_guard<std::mutex> lock {mutex};
+
+    if (worker.fd >= 0) {
+        close(worker.fd);
+        worker.fd = -1;
+    }
+
+    if (stopping)
+        return false;
+
+    // If even the spawner is gone, each following job will fail and try
+    // again; the pool can't do anything more useful than that
+    try {
+        auto child = spawner->spawn();
+        worker.pid = child.pid;
+        worker.fd = child.fd;
+        ++restartCount;
+    }
+    catch (std::runtime_error const &) {
+    }
+
+    return true;
+}
+
+
+EnginePool::~EnginePool () {
+    {
+        std::lock_guard<std::mutex> lock {mutex};
+        stopping = true;
+        pending.clear();
+
+        // Evaluations in progress may never finish on their own
+        for (auto & worker : workers) {
+            if (worker->fd < 0)
+                continue;
+            shutdown(worker->fd, SHUT_RDWR);
+            kill(worker->pid, SIGKILL);
+        }
+    }
+    jobAdded.notify_all();
+
+    for (auto & worker : workers) {
+        worker->thread.join();
+        if (worker->fd >= 0)
+            close(worker->fd);
+    }
+}
+
+
+Zygote::Zygote () :
+    Zygote (Block {})
+{
+}
+
+
+Zygote::Zygote (Block const & preload) {
+    runtime("do", preload);
+
+    spawner.reset(new internal::Spawner {&serveOneEvaluation});
+}
+
+
+optional<std::string> Zygote::run(std::string const & source) {
+    return runRequest("T" + source);
+}
+
+
+optional<std::string> Zygote::runRequest(std::string const & request) {
+    auto child = spawner->spawn();
+
+    std::string reply;
+    bool answered = internal::writeFrame(child.fd, request)
+        and internal::readFrame(child.fd, reply)
+        and not reply.empty();
+    close(child.fd);
+
+    if (not answered)
+        throw worker_lost {};
+
+    return takeReply(reply);
+}
+
+
+optional<AnyValue> Zygote::evaluate(Block const & code) {
+    return evaluateElsewhere(code, [this](std::string const & request) {
+        return runRequest(request);
+    });
+}
+
+
+Zygote::~Zygote () {
+}
+
+} // end namespace ren
+
+#endif
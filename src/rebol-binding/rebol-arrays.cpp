@@ -97,8 +97,9 @@ AnyArray::AnyArray (
 }
 
 
-// TBD: Finish version where you can use values directly as an array
-/*
+// The values are put in as they are--nothing is scanned, and words keep the
+// bindings they have.  A context given only says which engine to use.
+
 AnyArray::AnyArray (
     AnyValue const values[],
     size_t numValues,
@@ -110,20 +111,24 @@ AnyArray::AnyArray (
 {
     (this->*cellfun)(&this->cell);
 
+    RenEngineHandle handle = contextPtr
+        ? contextPtr->getEngine()
+        : (engine ? *engine : Engine::runFinder()).getHandle();
 
-    Context context = contextPtr ? *contextPtr : Context::current(engine);
+    // Not seen by the GC until it is put in the cell; the values it is
+    // filled from are kept alive by the caller
+    REBSER * array = Make_Array(static_cast<REBCNT>(numValues));
 
-    constructOrApplyInitialize(
-        context.getEngine(),
-        &context,
-        nullptr, // no applicand
-        loadables,
-        numLoadables,
-        this, // Do construct
-        nullptr // Don't apply
-    );
+    REBVAL item;
+    for (size_t index = 0; index < numValues; ++index) {
+        AnyValue::toCell_(item, values[index]);
+        Append_Value(array, &item);
+    }
+
+    Val_Init_Series(&this->cell, VAL_TYPE(&this->cell), array);
+
+    finishInit(handle);
 }
-*/
 
 
 
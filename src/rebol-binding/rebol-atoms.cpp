@@ -1,3 +1,6 @@
+#include <chrono>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 
 #include "rencpp/value.hpp"
@@ -18,6 +21,9 @@ bool AnyValue::isAtom() const {
         || IS_INTEGER(&cell)
         || IS_DECIMAL(&cell)
         || IS_DATE(&cell)
+        || IS_TIME(&cell)
+        || IS_PAIR(&cell)
+        || IS_TUPLE(&cell)
     );
 }
 
@@ -129,6 +135,22 @@ Character::operator wchar_t () const {
 }
 
 
+Character::Character (int i, Engine * engine) :
+    Atom (Dont::Initialize)
+{
+    // REBUNI is 16 bits wide
+    if (i < 0 or i > 0xFFFF)
+        throw std::out_of_range("Codepoint out of range for CHAR!");
+
+    SET_CHAR(&cell, static_cast<REBUNI>(i));
+
+    if (not engine)
+        engine = &Engine::runFinder();
+
+    finishInit(engine->getHandle());
+}
+
+
 unsigned long Character::codepoint() const {
     REBUNI uni = VAL_CHAR(&cell);
     // will probably not throw in Red, either
@@ -206,4 +228,258 @@ bool AnyValue::isDate() const {
 }
 
 
+//
+// Conversions between a day count from 1970-01-01 and the proleptic
+// Gregorian calendar, after http://howardhinnant.github.io/date_algorithms.html
+// (eras are 400 year cycles, and years are taken to start in March so the
+// leap day falls at the end)
+//
+
+namespace {
+
+int64_t daysFromCivil(int64_t year, int64_t month, int64_t day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5
+        + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100
+        + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+void civilFromDays(int64_t days, int64_t & year, int & month, int & day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (
+        dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096
+    ) / 365;
+    int64_t dayOfYear = dayOfEra
+        - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t monthShifted = (5 * dayOfYear + 2) / 153;
+
+    day = static_cast<int>(dayOfYear - (153 * monthShifted + 2) / 5 + 1);
+    month = static_cast<int>(
+        monthShifted < 10 ? monthShifted + 3 : monthShifted - 9
+    );
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+int daysInMonth(int64_t year, int month) {
+    static int const days[12] = {
+        31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+    };
+    if (month == 2 and year % 4 == 0 and (year % 100 != 0 or year % 400 == 0))
+        return 29;
+    return days[month - 1];
+}
+
+int64_t const nanosecondsPerDay = INT64_C(86400000000000);
+
+// The year field of a date cell is 16 bits
+int64_t const maxYear = 65535;
+
+
+void initDateCell(
+    REBVAL & cell, int64_t year, int month, int day, REBI64 nanoseconds
+) {
+    if (year < 0 or year > maxYear)
+        throw std::out_of_range {"Year out of range for DATE!"};
+
+    VAL_SET(&cell, REB_DATE);
+    VAL_YEAR(&cell) = static_cast<REBCNT>(year);
+    VAL_MONTH(&cell) = static_cast<REBCNT>(month);
+    VAL_DAY(&cell) = static_cast<REBCNT>(day);
+    VAL_ZONE(&cell) = 0;
+    VAL_TIME(&cell) = nanoseconds;
+}
+
+} // end anonymous namespace
+
+
+Date::Date (
+    std::chrono::system_clock::time_point when,
+    Engine * engine
+) :
+    Atom (Dont::Initialize)
+{
+    using std::chrono::duration_cast;
+
+    // Split into whole seconds first, as a clock with a coarser tick than
+    // nanoseconds may hold times that would overflow if counted in them
+    auto sinceEpoch = when.time_since_epoch();
+    auto seconds = duration_cast<std::chrono::seconds>(sinceEpoch);
+    int64_t fraction = duration_cast<std::chrono::nanoseconds>(
+        sinceEpoch - seconds
+    ).count();
+
+    // Division that rounds down, so times before 1970 land on the day before
+    int64_t days = seconds.count() / 86400;
+    int64_t nanoseconds = (seconds.count() % 86400) * 1000000000 + fraction;
+    if (nanoseconds < 0) {
+        days -= 1;
+        nanoseconds += nanosecondsPerDay;
+    }
+
+    int64_t year;
+    int month;
+    int day;
+    civilFromDays(days, year, month, day);
+
+    initDateCell(cell, year, month, day, nanoseconds);
+    finishInit((engine ? *engine : Engine::runFinder()).getHandle());
+}
+
+
+Date::Date (int year, int month, int day, Engine * engine) :
+    Atom (Dont::Initialize)
+{
+    if (month < 1 or month > 12)
+        throw std::out_of_range {"Month out of range for DATE!"};
+    if (day < 1 or day > daysInMonth(year, month))
+        throw std::out_of_range {"Day out of range for DATE!"};
+
+    initDateCell(cell, year, month, day, NO_TIME);
+    finishInit((engine ? *engine : Engine::runFinder()).getHandle());
+}
+
+
+int Date::year() const {
+    return static_cast<int>(VAL_YEAR(&cell));
+}
+
+
+int Date::month() const {
+    return static_cast<int>(VAL_MONTH(&cell));
+}
+
+
+int Date::day() const {
+    return static_cast<int>(VAL_DAY(&cell));
+}
+
+
+Date::operator std::chrono::system_clock::time_point () const {
+    using std::chrono::system_clock;
+
+    int64_t days = daysFromCivil(year(), month(), day());
+
+    // Zones are counted in units of ZONE_MINS minutes, ahead of UTC
+    int64_t seconds = days * 86400
+        - static_cast<int64_t>(VAL_ZONE(&cell)) * ZONE_MINS * 60;
+
+    // Checked in seconds, which can't overflow for a 16-bit year
+    int64_t const limit = std::chrono::duration_cast<std::chrono::seconds>(
+        system_clock::duration::max()
+    ).count() - 86400;
+    if (seconds > limit or seconds < -limit)
+        throw std::out_of_range {"DATE! out of range for system_clock"};
+
+    system_clock::time_point result {std::chrono::seconds {seconds}};
+    if (VAL_TIME(&cell) != NO_TIME)
+        result += std::chrono::duration_cast<system_clock::duration>(
+            std::chrono::nanoseconds {VAL_TIME(&cell)}
+        );
+    return result;
+}
+
+
+
+//
+// TIME
+//
+
+bool AnyValue::isTime() const {
+    return IS_TIME(&cell);
+}
+
+
+Time::Time (std::chrono::nanoseconds duration, Engine * engine) :
+    Atom (Dont::Initialize)
+{
+    // NO_TIME is the one value the cell can't hold, as it means a DATE!
+    // has no time component
+    if (duration.count() == NO_TIME)
+        throw std::out_of_range {"Duration out of range for TIME!"};
+
+    VAL_SET(&cell, REB_TIME);
+    VAL_TIME(&cell) = duration.count();
+    finishInit((engine ? *engine : Engine::runFinder()).getHandle());
+}
+
+
+Time::operator std::chrono::nanoseconds () const {
+    return std::chrono::nanoseconds {VAL_TIME(&cell)};
+}
+
+
+
+//
+// PAIR
+//
+
+bool AnyValue::isPair() const {
+    return IS_PAIR(&cell);
+}
+
+
+Pair::Pair (double x, double y, Engine * engine) :
+    Atom (Dont::Initialize)
+{
+    SET_PAIR(&cell, static_cast<float>(x), static_cast<float>(y));
+    finishInit((engine ? *engine : Engine::runFinder()).getHandle());
+}
+
+
+double Pair::x() const {
+    return VAL_PAIR_X(&cell);
+}
+
+
+double Pair::y() const {
+    return VAL_PAIR_Y(&cell);
+}
+
+
+
+//
+// TUPLE
+//
+
+bool AnyValue::isTuple() const {
+    return IS_TUPLE(&cell);
+}
+
+
+Tuple::Tuple (
+    unsigned char const components[],
+    size_t count,
+    Engine * engine
+) :
+    Atom (Dont::Initialize)
+{
+    if (count < 3 or count > MAX_TUPLE)
+        throw std::length_error {"TUPLE! must have 3 to 10 components"};
+
+    VAL_SET(&cell, REB_TUPLE);
+    VAL_TUPLE_LEN(&cell) = static_cast<REBYTE>(count);
+    std::memset(VAL_TUPLE(&cell), 0, MAX_TUPLE);
+    std::memcpy(VAL_TUPLE(&cell), components, count);
+    finishInit((engine ? *engine : Engine::runFinder()).getHandle());
+}
+
+
+size_t Tuple::size() const {
+    return VAL_TUPLE_LEN(&cell);
+}
+
+
+unsigned char Tuple::operator[](size_t index) const {
+    if (index == 0 or index > size())
+        throw std::out_of_range {"TUPLE! index out of range"};
+    return VAL_TUPLE(&cell)[index - 1];
+}
+
+
 } // end namespace ren
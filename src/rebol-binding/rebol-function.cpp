@@ -1,7 +1,9 @@
+#include <limits>
 #include <stdexcept>
 
 #include "rencpp/value.hpp"
 #include "rencpp/function.hpp"
+#include "rencpp/error.hpp"
 
 
 namespace ren {
@@ -51,6 +53,142 @@ void Function::finishInitSpecial(
     AnyValue::finishInit(engine);
 }
 
+
+RenShimPointer Function::getShim() const {
+    return IS_NATIVE(&cell) ? VAL_FUNC_CODE(&cell) : nullptr;
+}
+
+
+
+//
+// CELL CODECS FOR PLAIN C++ TYPES
+//
+
+//
+// These are only used on call frame cells, which the native's spec has
+// already type checked.  So a mismatch means the spec and the C++ signature
+// disagree, which is reported as an error in the runtime.
+//
+
+namespace internal {
+
+static bool isAnyArrayCell(REBVAL const * cell) {
+    return IS_BLOCK(cell) or IS_PAREN(cell) or IS_PATH(cell)
+        or IS_SET_PATH(cell) or IS_GET_PATH(cell) or IS_LIT_PATH(cell);
+}
+
+
+int64_t CellCodec<int64_t>::fromCell(RenCell const & cell, RenEngineHandle) {
+    if (not IS_INTEGER(&cell))
+        throw Error {"INTEGER! expected for int64_t native argument"};
+    return VAL_INT64(&cell);
+}
+
+void CellCodec<int64_t>::toCell(
+    RenCell & cell, int64_t value, RenEngineHandle
+) {
+    SET_INTEGER(&cell, value);
+}
+
+
+int CellCodec<int>::fromCell(RenCell const & cell, RenEngineHandle engine) {
+    int64_t value = CellCodec<int64_t>::fromCell(cell, engine);
+    if (
+        value < std::numeric_limits<int>::min()
+        or value > std::numeric_limits<int>::max()
+    ) {
+        throw Error {"INTEGER! out of range for int native argument"};
+    }
+    return static_cast<int>(value);
+}
+
+void CellCodec<int>::toCell(RenCell & cell, int value, RenEngineHandle) {
+    SET_INTEGER(&cell, value);
+}
+
+
+double CellCodec<double>::fromCell(RenCell const & cell, RenEngineHandle) {
+    // [number!] specs are common, so an INTEGER! is accepted too
+    if (IS_DECIMAL(&cell))
+        return VAL_DECIMAL(&cell);
+    if (IS_INTEGER(&cell))
+        return static_cast<double>(VAL_INT64(&cell));
+    throw Error {"DECIMAL! expected for double native argument"};
+}
+
+void CellCodec<double>::toCell(RenCell & cell, double value, RenEngineHandle) {
+    SET_DECIMAL(&cell, value);
+}
+
+
+bool CellCodec<bool>::fromCell(RenCell const & cell, RenEngineHandle) {
+    if (not IS_LOGIC(&cell))
+        throw Error {"LOGIC! expected for bool native argument"};
+    return VAL_LOGIC(&cell);
+}
+
+void CellCodec<bool>::toCell(RenCell & cell, bool value, RenEngineHandle) {
+    SET_LOGIC(&cell, value);
+}
+
+
+std::string CellCodec<std::string>::fromCell(
+    RenCell const & cell, RenEngineHandle
+) {
+    if (not ANY_STR(&cell))
+        throw Error {"ANY-STRING! expected for std::string native argument"};
+
+    REBSER * utf8 = Make_UTF8_From_Any_String(
+        const_cast<REBVAL *>(&cell), VAL_LEN(&cell), 0
+    );
+
+    std::string result (
+        reinterpret_cast<char const *>(SERIES_DATA(utf8)),
+        SERIES_LEN(utf8)
+    );
+
+    Free_Series(utf8);
+    return result;
+}
+
+void CellCodec<std::string>::toCell(
+    RenCell & cell, std::string const & value, RenEngineHandle
+) {
+    // Decodes straight into a new series, no scanning
+    REBSER * series = Append_UTF8(
+        nullptr,
+        reinterpret_cast<REBYTE const *>(value.data()),
+        static_cast<REBINT>(value.size())
+    );
+
+    Val_Init_Series(&cell, REB_STRING, series);
+}
+
+
+void initBlockCell(RenCell & cell, size_t capacity) {
+    Val_Init_Series(
+        &cell, REB_BLOCK, Make_Array(static_cast<REBCNT>(capacity))
+    );
+}
+
+void appendToBlockCell(RenCell & block, RenCell const & item) {
+    Append_Value(VAL_SERIES(&block), &item);
+}
+
+size_t blockCellLength(RenCell const & block) {
+    if (not isAnyArrayCell(&block))
+        throw Error {"ANY-BLOCK! expected for std::vector native argument"};
+    return VAL_LEN(&block);
+}
+
+RenCell const & blockCellAt(RenCell const & block, size_t index) {
+    return *BLK_SKIP(
+        VAL_SERIES(&block), VAL_INDEX(&block) + static_cast<REBCNT>(index)
+    );
+}
+
+} // end namespace internal
+
 #endif
 
 } // end namespace ren
@@ -1,8 +1,11 @@
 #ifndef NDEBUG
+#include <atomic>
 #include <unordered_set>
 #include <unordered_map>
 #endif
 #include <cassert>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 
 #include "rencpp/rebol.hpp"
@@ -31,11 +34,67 @@ private:
     RebolEngineHandle theEngine; // currently only support one "Engine"
     REBSER * allocatedContexts;
 
+    // Set by ExceedBudget() from the host when a deadline passes, to tell its
+    // halt apart from others when it lands in ConstructOrApply
+    std::atomic<bool> budgetExceeded;
+
+
+private:
+    // Can raise errors, so it must be called with a trap pushed.  Text
+    // that isn't known to have a NUL after it is copied first, as parts of
+    // the scanner stop only on one; the copy is an unmanaged series, so it
+    // is freed if the scan raises an error as well as after it.
+
+    static REBSER * scanAndBind(
+        REBYTE const * utf8,
+        REBCNT size,
+        bool terminated,
+        REBVAL const * context
+    ) {
+        REBSER * transcoded;
+        if (terminated)
+            transcoded = Scan_Source(const_cast<REBYTE *>(utf8), size);
+        else {
+            REBSER * copy = Make_Binary(size);
+            memcpy(BIN_HEAD(copy), utf8, size);
+            BIN_HEAD(copy)[size] = 0;
+            copy->tail = size;
+
+            transcoded = Scan_Source(BIN_HEAD(copy), size);
+            Free_Series(copy);
+        }
+
+        if (context) {
+            // Binding Do_String did by default...except it only
+            // worked with the user context.  Fell through to lib.
+
+            REBCNT len = VAL_OBJ_FRAME(context)->tail;
+
+            if (len > 0)
+                ASSERT_VALUE_MANAGED(BLK_HEAD(transcoded));
+
+            Bind_Values_All_Deep(
+                BLK_HEAD(transcoded),
+                VAL_OBJ_FRAME(context)
+            );
+
+            REBVAL vali;
+            SET_INTEGER(&vali, len);
+
+            Resolve_Context(
+                VAL_OBJ_FRAME(context), Lib_Context, &vali, FALSE, 0
+            );
+        }
+
+        return transcoded;
+    }
+
 
 public:
     RebolHooks () :
         theEngine (REBOL_ENGINE_HANDLE_INVALID),
-        allocatedContexts (nullptr)
+        allocatedContexts (nullptr),
+        budgetExceeded (false)
     {
     }
 
@@ -56,6 +115,19 @@ public:
 
         runtime.lazyInitializeIfNecessary();
 
+        // The evaluator only checks Eval_Limit and PG_Mem_Limit on behalf
+        // of the security policies for EVAL and MEMORY, which by default
+        // let them be passed; make passing them raise an error instead
+        REBVAL * policies = Get_System(SYS_STATE, STATE_POLICIES);
+        REBCNT const limited[] = {SYM_EVAL, SYM_MEMORY};
+        for (REBCNT sym : limited) {
+            REBVAL * policy = Find_Word_Value(VAL_OBJ_FRAME(policies), sym);
+            assert(policy);
+            VAL_SET(policy, REB_TUPLE);
+            VAL_TUPLE_LEN(policy) = 3;
+            std::memset(VAL_TUPLE(policy), SEC_THROW, 3);
+        }
+
         assert(not GC_Mark_Hook);
         GC_Mark_Hook = &::Queue_Mark_Host_Deep;
 
@@ -72,6 +144,8 @@ public:
         if (REBOL_IS_ENGINE_HANDLE_INVALID(engine))
             return REN_BAD_ENGINE_HANDLE;
 
+        runtime.stdioEngine = nullptr;
+
         // Any values that have been allocated globally or statically will
         // still exist.  There isn't anyway to guarantee they will have
         // their destructors run before the shutdown of the runtime...which
@@ -192,10 +266,22 @@ public:
 
             if (VAL_ERR_NUM(error) == RE_HALT) {
                 // cancellation in middle of interpretation from outside
-                // the evaluation loop (e.g. Escape).
+                // the evaluation loop (e.g. Escape), or by the host when
+                // a budget ran out
+                if (budgetExceeded.exchange(false))
+                    return REN_BUDGET_EXCEEDED;
                 return REN_EVALUATION_HALTED;
             }
 
+            if (VAL_ERR_NUM(error) == RE_SECURITY) {
+                // What LimitUsage() set being passed is reported through
+                // the EVAL and MEMORY policies (see AllocEngine())
+                if (Eval_Limit != 0 and Eval_Cycles > Eval_Limit)
+                    return REN_EVAL_STEPS_EXCEEDED;
+                if (PG_Mem_Limit != 0 and PG_Mem_Usage > PG_Mem_Limit)
+                    return REN_MEMORY_EXCEEDED;
+            }
+
             *extraOut = *error;
 
             return applying ? REN_APPLY_ERROR : REN_CONSTRUCT_ERROR;
@@ -238,40 +324,21 @@ public:
                 // get through transcode which returns [foo bar] and
                 // [[foo bar]] that discern the cases
 
-                auto loadText = reinterpret_cast<REBYTE*>(
-                    VAL_HANDLE_DATA(cell)
-                );
+                // The Loadable put the text's length in the index slot,
+                // and marked it if there's a NUL after the text
+
+                auto loadText = reinterpret_cast<REBYTE*>(VAL_SERIES(cell));
+                REBCNT loadSize = VAL_INDEX(cell) & ~loadableTerminated;
+                bool loadTerminated = VAL_INDEX(cell) & loadableTerminated;
 
                 // CAN raise errors and longjmp backwards on the C stack to
                 // the `if (error)` case above!  These are the errors that
                 // happen if the input is bad (unmatched parens, etc...)
 
-                REBSER * transcoded = Scan_Source(
-                    loadText, LEN_BYTES(loadText)
+                REBSER * transcoded = scanAndBind(
+                    loadText, loadSize, loadTerminated, context
                 );
 
-                if (context) {
-                    // Binding Do_String did by default...except it only
-                    // worked with the user context.  Fell through to lib.
-
-                    REBCNT len = VAL_OBJ_FRAME(context)->tail;
-
-                    if (len > 0)
-                        ASSERT_VALUE_MANAGED(BLK_HEAD(transcoded));
-
-                    Bind_Values_All_Deep(
-                        BLK_HEAD(transcoded),
-                        VAL_OBJ_FRAME(context)
-                    );
-
-                    REBVAL vali;
-                    SET_INTEGER(&vali, len);
-
-                    Resolve_Context(
-                        VAL_OBJ_FRAME(context), Lib_Context, &vali, FALSE, 0
-                    );
-                }
-
                 // Might think to use Append_Block here, but it's under
                 // an #ifdef and apparently unused.  This is its definition.
 
@@ -488,11 +555,126 @@ public:
         return result;
     }
 
+    RenResult LoadUtf8(
+        RebolEngineHandle engine,
+        REBVAL const * context,
+        unsigned char const * utf8,
+        size_t size,
+        int terminated,
+        REBVAL * blockOut,
+        REBVAL * errorOut
+    ) {
+        assert(engine.data == 1020);
+
+        if (size > std::numeric_limits<REBCNT>::max())
+            throw std::runtime_error("Source too large for Rebol to scan");
+
+        REBOL_STATE state;
+        const REBVAL * error;
+
+        PUSH_UNHALTABLE_TRAP(&error, &state);
+
+// The first time through the following code 'error' will be NULL, but...
+// `raise Error()` can longjmp here, 'error' won't be NULL *if* that happens!
+
+        if (error) {
+            *errorOut = *error;
+            return REN_CONSTRUCT_ERROR;
+        }
+
+        // The scanner is given the length, and reads terminated text where
+        // it is
+        Val_Init_Block(
+            blockOut,
+            scanAndBind(
+                utf8, static_cast<REBCNT>(size), terminated != 0, context
+            )
+        );
+
+        DROP_TRAP_SAME_STACKLEVEL_AS_PUSH(&state);
+
+        return REN_SUCCESS;
+    }
+
+    RenResult LimitUsage(
+        RebolEngineHandle engine,
+        uint64_t maxEvalSteps,
+        uint64_t maxMemoryBytes,
+        uint64_t * evalLimitOut,
+        uint64_t * memoryLimitOut
+    ) {
+        assert(engine.data == 1020);
+
+        // The limits are absolute, and checked by the evaluator as it polls
+        // for signals (and by the allocator); an enclosing budget's limit is
+        // kept if it is the tighter one
+        *evalLimitOut = static_cast<uint64_t>(Eval_Limit);
+        *memoryLimitOut = static_cast<uint64_t>(PG_Mem_Limit);
+
+        if (maxEvalSteps != 0) {
+            uint64_t limit = static_cast<uint64_t>(Eval_Cycles) + maxEvalSteps;
+            if (*evalLimitOut == 0 or limit < *evalLimitOut)
+                Eval_Limit = static_cast<decltype(Eval_Limit)>(limit);
+        }
+
+        if (maxMemoryBytes != 0) {
+            uint64_t limit
+                = static_cast<uint64_t>(PG_Mem_Usage) + maxMemoryBytes;
+            if (*memoryLimitOut == 0 or limit < *memoryLimitOut)
+                PG_Mem_Limit = static_cast<decltype(PG_Mem_Limit)>(limit);
+        }
+
+        return REN_SUCCESS;
+    }
+
+    RenResult RestoreUsageLimits(
+        RebolEngineHandle engine,
+        uint64_t evalLimit,
+        uint64_t memoryLimit
+    ) {
+        assert(engine.data == 1020);
+
+        Eval_Limit = static_cast<decltype(Eval_Limit)>(evalLimit);
+        PG_Mem_Limit = static_cast<decltype(PG_Mem_Limit)>(memoryLimit);
+
+        return REN_SUCCESS;
+    }
+
+    RenResult ExceedBudget(RebolEngineHandle engine) {
+        assert(engine.data == 1020);
+
+        budgetExceeded.store(true);
+        SET_SIGNAL(SIG_ESCAPE);
+
+        return REN_SUCCESS;
+    }
+
+    RenResult RetractBudget(RebolEngineHandle engine) {
+        assert(engine.data == 1020);
+
+        // Only if the halt is still pending; once ConstructOrApply has
+        // taken it the flag is already clear, and the signal may since
+        // have been raised for some other reason
+        if (budgetExceeded.exchange(false))
+            CLR_SIGNAL(SIG_ESCAPE);
+
+        return REN_SUCCESS;
+    }
+
     RenResult ShimHalt() {
         raise Error_Is(TASK_HALT_ERROR);
         DEAD_END;
     }
 
+    int ShimHaltRequested() {
+        // Runtime::cancel() raises the same signal the evaluator loop polls
+        if (not GET_SIGNAL(SIG_ESCAPE))
+            return 0;
+
+        CLR_SIGNAL(SIG_ESCAPE);
+        return 1;
+    }
+
     void ShimInitThrown(REBVAL *out, REBVAL const *value, REBVAL const *name) {
 		if (name)
 			*out = *name;
@@ -605,11 +787,65 @@ RenResult RenFormAsUtf8(
 }
 
 
+RenResult RenLoadUtf8(
+    RebolEngineHandle engine,
+    REBVAL const * context,
+    unsigned char const * utf8,
+    size_t size,
+    int terminated,
+    REBVAL * blockOut,
+    REBVAL * errorOut
+) {
+    return ren::internal::hooks.LoadUtf8(
+        engine, context, utf8, size, terminated, blockOut, errorOut
+    );
+}
+
+
+RenResult RenLimitUsage(
+    RebolEngineHandle engine,
+    uint64_t maxEvalSteps,
+    uint64_t maxMemoryBytes,
+    uint64_t * evalLimitOut,
+    uint64_t * memoryLimitOut
+) {
+    return ren::internal::hooks.LimitUsage(
+        engine, maxEvalSteps, maxMemoryBytes, evalLimitOut, memoryLimitOut
+    );
+}
+
+
+RenResult RenRestoreUsageLimits(
+    RebolEngineHandle engine,
+    uint64_t evalLimit,
+    uint64_t memoryLimit
+) {
+    return ren::internal::hooks.RestoreUsageLimits(
+        engine, evalLimit, memoryLimit
+    );
+}
+
+
+RenResult RenExceedBudget(RebolEngineHandle engine) {
+    return ren::internal::hooks.ExceedBudget(engine);
+}
+
+
+RenResult RenRetractBudget(RebolEngineHandle engine) {
+    return ren::internal::hooks.RetractBudget(engine);
+}
+
+
 RenResult RenShimHalt() {
     return ren::internal::hooks.ShimHalt();
 }
 
 
+int RenShimHaltRequested() {
+    return ren::internal::hooks.ShimHaltRequested();
+}
+
+
 void RenShimInitThrown(REBVAL *out, REBVAL const *value, REBVAL const *name) {
     ren::internal::hooks.ShimInitThrown(out, value, name);
 }
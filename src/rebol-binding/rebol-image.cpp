@@ -1,3 +1,5 @@
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 
 #include "rencpp/value.hpp"
@@ -15,38 +17,163 @@ bool AnyValue::isImage() const {
     return IS_IMAGE(&cell);
 }
 
-#if REN_CLASSLIB_QT == 1
-
-Image::Image (QImage const & image, Engine * engine) {
-    // need to convert if this isn't true
-    assert(image.format() == QImage::Format_ARGB32);
 
-    REBCNT width = static_cast<REBCNT>(image.width());
-    REBCNT height = static_cast<REBCNT>(image.height());
+Image::Image (size_t width, size_t height, Engine * engine) :
+    AnyValue (Dont::Initialize)
+{
+    if (
+        width > std::numeric_limits<REBCNT>::max()
+        or height > std::numeric_limits<REBCNT>::max()
+        or (height != 0 and width > std::numeric_limits<REBCNT>::max() / height)
+    ) {
+        throw std::length_error {"Image dimensions too large"};
+    }
 
-    VAL_SET(&cell, REB_IMAGE);
-    REBSER * img = Make_Image(width, height, FALSE);
-    std::copy(
-        image.bits(),
-        image.bits() + (sizeof(char[4]) * width * height),
-        IMG_DATA(img)
+    REBSER * img = Make_Image(
+        static_cast<REBCNT>(width), static_cast<REBCNT>(height), FALSE
     );
+    if (not img)
+        throw std::length_error {"Image dimensions too large"};
+
+    std::memset(IMG_DATA(img), 0, sizeof(REBCNT) * width * height);
+
     Val_Init_Image(&cell, img);
-    finishInit(engine->getHandle());
+    finishInit((engine ? *engine : Engine::runFinder()).getHandle());
+}
+
+
+Image::Image (
+    void const * pixels,
+    size_t width,
+    size_t height,
+    size_t stride,
+    PixelFormat format,
+    Engine * engine
+) :
+    Image (width, height, engine)
+{
+    auto from = static_cast<unsigned char const *>(pixels);
+    auto to = reinterpret_cast<unsigned char *>(IMG_DATA(VAL_SERIES(&cell)));
+
+    for (size_t y = 0; y < height; ++y)
+        convertPixels(
+            from + y * stride,
+            format,
+            to + y * width * sizeof(REBCNT),
+            nativePixelFormat,
+            width
+        );
+}
+
+
+size_t Image::width() const {
+    return VAL_IMAGE_WIDE(&cell);
+}
+
+
+size_t Image::height() const {
+    return VAL_IMAGE_HIGH(&cell);
+}
+
+
+void Image::copyPixelsTo(
+    void * pixels, size_t stride, PixelFormat format
+) const {
+    size_t w = width();
+    auto from = reinterpret_cast<unsigned char const *>(
+        IMG_DATA(VAL_SERIES(&cell))
+    );
+    auto to = static_cast<unsigned char *>(pixels);
+
+    for (size_t y = 0; y < height(); ++y)
+        convertPixels(
+            from + y * w * sizeof(REBCNT),
+            nativePixelFormat,
+            to + y * stride,
+            format,
+            w
+        );
+}
+
+
+PixelSpan Image::pixels() const {
+    return PixelSpan {*this};
+}
+
+
+#if REN_CLASSLIB_QT == 1
+
+Image::Image (QImage const & image, Engine * engine) :
+    Image (
+        image.width() > 0 ? static_cast<size_t>(image.width()) : 0,
+        image.height() > 0 ? static_cast<size_t>(image.height()) : 0,
+        engine
+    )
+{
+    QImage argb = image.convertToFormat(QImage::Format_ARGB32);
+
+    auto to = reinterpret_cast<unsigned char *>(IMG_DATA(VAL_SERIES(&cell)));
+    size_t rowBytes = sizeof(REBCNT) * width();
+
+    for (size_t y = 0; y < height(); ++y)
+        std::memcpy(
+            to + y * rowBytes, argb.constScanLine(static_cast<int>(y)), rowBytes
+        );
 }
 
 
 Image::operator QImage () const {
     QImage result {
-        VAL_IMAGE_DATA(&cell),
+        reinterpret_cast<uchar const *>(IMG_DATA(VAL_SERIES(&cell))),
         static_cast<int>(VAL_IMAGE_WIDE(&cell)),
         static_cast<int>(VAL_IMAGE_HIGH(&cell)),
         QImage::Format_ARGB32
     };
 
-    return result;
+    // A QImage made over memory uses it in place, but the series may be
+    // freed or moved by the runtime while the QImage is still around
+    return result.copy();
 }
 
 #endif
 
+
+
+//
+// PIXEL SPAN
+//
+
+// Protecting the series is what PROTECT does, so script code that tries to
+// modify the image while a span is out gets an error
+
+PixelSpan::PixelSpan (Image const & image) :
+    image (image),
+    bits (reinterpret_cast<uint32_t *>(IMG_DATA(VAL_SERIES(&image.cell)))),
+    w (VAL_IMAGE_WIDE(&image.cell)),
+    h (VAL_IMAGE_HIGH(&image.cell)),
+    pinned (not IS_PROTECT_SERIES(VAL_SERIES(&image.cell)))
+{
+    static_assert(sizeof(REBCNT) == sizeof(uint32_t), "pixels not 32-bit");
+
+    if (pinned)
+        PROTECT_SERIES(VAL_SERIES(&image.cell));
+}
+
+
+PixelSpan::PixelSpan (PixelSpan && other) :
+    image (other.image),
+    bits (other.bits),
+    w (other.w),
+    h (other.h),
+    pinned (other.pinned)
+{
+    other.pinned = false;
+}
+
+
+PixelSpan::~PixelSpan () {
+    if (pinned)
+        UNPROTECT_SERIES(VAL_SERIES(&image.cell));
+}
+
 } // end namespace ren
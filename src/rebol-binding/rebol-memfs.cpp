@@ -0,0 +1,328 @@
+//
+// rebol-memfs.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+//
+// Like rebol-stdio.cpp, this is modeled after a device from Rebol's host
+// kit (dev-file.c).  Rather than replace the file device, the commands
+// that take a path are put in front of it: requests for files in one of
+// the MemoryFiles mounts (see memfs.hpp) are handled here, and all others
+// are passed on to the host's file device as before.
+//
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <unordered_set>
+
+#include "rencpp/rebol.hpp"
+#include "rencpp/memfs.hpp"
+
+#ifdef TO_WINDOWS
+    #include <windows.h>
+#endif
+
+
+extern REBDEV *Devices[];
+
+
+namespace {
+
+// The host file device's own commands, which the ones here fall back on
+DEVICE_CMD_FUNC *Host_File_Cmds = nullptr;
+
+DEVICE_CMD_FUNC Mem_File_Cmds[RDC_MAX];
+
+
+struct Mem_File {
+    std::shared_ptr<ren::MemoryFiles> files;
+    std::string name;
+    uint64_t position;
+};
+
+// Requests opened here are told apart from ones opened by the host device
+// by their handle, as the mount could be gone by the time they're closed
+std::unordered_set<void *> Open_Mem_Files;
+
+
+std::string Local_Path(REBCHR const * path)
+{
+#ifdef TO_WINDOWS
+    auto wide = reinterpret_cast<wchar_t const *>(path);
+    int size = WideCharToMultiByte(CP_UTF8, 0, wide, -1, NULL, 0, NULL, NULL);
+    std::string result (static_cast<size_t>(size > 0 ? size - 1 : 0), '\0');
+    if (size > 1)
+        WideCharToMultiByte(CP_UTF8, 0, wide, -1, &result[0], size, NULL, NULL);
+    for (auto & ch : result)
+        if (ch == '\\')
+            ch = '/';
+    return result;
+#else
+    return reinterpret_cast<char const *>(path);
+#endif
+}
+
+
+Mem_File *Mem_File_Of(REBREQ *req)
+{
+    void *handle = req->requestee.handle;
+    if (handle and Open_Mem_Files.count(handle))
+        return static_cast<Mem_File *>(handle);
+    return nullptr;
+}
+
+
+std::shared_ptr<ren::MemoryFiles> Mount_Of(REBREQ *req, std::string *name)
+{
+    if (not req->special.file.path)
+        return nullptr;
+    return ren::internal::findMountedFiles(
+        Local_Path(req->special.file.path), name
+    );
+}
+
+
+DEVICE_CMD Fail(REBREQ *req, int error)
+{
+    req->error = error;
+    return DR_ERROR;
+}
+
+
+DEVICE_CMD Open_Mem_File(
+    REBREQ *req,
+    std::shared_ptr<ren::MemoryFiles> files,
+    std::string const & name
+) {
+    if (GET_FLAG(req->modes, RFM_DIR))
+        return Fail(req, ENOTDIR);
+
+    // Same rule as dev-file.c for when opening to write truncates
+    bool write = GET_FLAG(req->modes, RFM_WRITE);
+    bool truncate = write and (
+        GET_FLAG(req->modes, RFM_NEW)
+        or not (
+            GET_FLAG(req->modes, RFM_READ)
+            or GET_FLAG(req->modes, RFM_APPEND)
+            or GET_FLAG(req->modes, RFM_SEEK)
+        )
+    );
+
+    if (not files->open(name, write, truncate))
+        return Fail(req, write ? EACCES : ENOENT);
+
+    uint64_t size = 0;
+    files->query(name, &size);
+    req->special.file.size = static_cast<REBI64>(size);
+
+    auto file = new Mem_File {std::move(files), name, 0};
+    req->requestee.handle = file;
+    Open_Mem_Files.insert(file);
+
+    return DR_DONE;
+}
+
+
+DEVICE_CMD Close_Mem_File(REBREQ *req, Mem_File *file)
+{
+    Open_Mem_Files.erase(file);
+    delete file;
+    req->requestee.handle = nullptr;
+    return DR_DONE;
+}
+
+
+void Seek_If_Asked(REBREQ *req, Mem_File *file)
+{
+    if (GET_FLAG(req->modes, RFM_SEEK) or GET_FLAG(req->modes, RFM_RESEEK)) {
+        CLR_FLAG(req->modes, RFM_RESEEK);
+        file->position = static_cast<uint64_t>(req->special.file.index);
+    }
+}
+
+
+DEVICE_CMD Read_Mem_File(REBREQ *req, Mem_File *file)
+{
+    Seek_If_Asked(req, file);
+
+    size_t count = file->files->read(
+        file->name,
+        file->position,
+        reinterpret_cast<char *>(req->common.data),
+        req->length
+    );
+
+    file->position += count;
+    req->actual = static_cast<u32>(count);
+    req->special.file.index += static_cast<REBI64>(count);
+    return DR_DONE;
+}
+
+
+DEVICE_CMD Write_Mem_File(REBREQ *req, Mem_File *file)
+{
+    if (GET_FLAG(req->modes, RFM_APPEND)) {
+        CLR_FLAG(req->modes, RFM_APPEND);
+        uint64_t size = 0;
+        file->files->query(file->name, &size);
+        file->position = size;
+    }
+    Seek_If_Asked(req, file);
+
+    if (not file->files->write(
+        file->name,
+        file->position,
+        reinterpret_cast<char const *>(req->common.data),
+        req->length
+    )) {
+        return Fail(req, EACCES);
+    }
+
+    file->position += req->length;
+    req->actual = req->length;
+    return DR_DONE;
+}
+
+
+DEVICE_CMD Query_Mem_File(
+    REBREQ *req,
+    ren::MemoryFiles const & files,
+    std::string const & name
+) {
+    uint64_t size;
+    if (not files.query(name, &size))
+        return Fail(req, ENOENT);
+
+    req->special.file.size = static_cast<REBI64>(size);
+    CLR_FLAG(req->modes, RFM_DIR);
+    memset(&req->special.file.time, 0, sizeof(req->special.file.time));
+    return DR_DONE;
+}
+
+
+DEVICE_CMD Rename_Mem_File(
+    REBREQ *req,
+    std::shared_ptr<ren::MemoryFiles> const & files,
+    std::string const & name
+) {
+    std::string newName;
+    auto newFiles = ren::internal::findMountedFiles(
+        Local_Path(reinterpret_cast<REBCHR *>(req->common.data)), &newName
+    );
+
+    // Moving files between mounts (or out to the disk) isn't supported
+    if (newFiles != files)
+        return Fail(req, EXDEV);
+
+    return files->rename(name, newName) ? DR_DONE : Fail(req, ENOENT);
+}
+
+
+DEVICE_CMD Host_File_Command(REBREQ *req)
+{
+    DEVICE_CMD_FUNC command = Host_File_Cmds[req->command];
+    if (not command)
+        return Fail(req, ENOSYS);
+    return command(req);
+}
+
+
+DEVICE_CMD Mem_File_Command(REBREQ *req)
+{
+    // Requests that are already open go to whoever opened them
+
+    if (Mem_File *file = Mem_File_Of(req)) {
+        switch (req->command) {
+        case RDC_READ:
+            return Read_Mem_File(req, file);
+
+        case RDC_WRITE:
+            return Write_Mem_File(req, file);
+
+        case RDC_CLOSE:
+            return Close_Mem_File(req, file);
+
+        case RDC_QUERY:
+            return Query_Mem_File(req, *file->files, file->name);
+
+        default:
+            return Fail(req, ENOSYS);
+        }
+    }
+
+    std::string name;
+    auto files = Mount_Of(req, &name);
+    if (not files)
+        return Host_File_Command(req);
+
+    switch (req->command) {
+    case RDC_OPEN:
+        return Open_Mem_File(req, std::move(files), name);
+
+    case RDC_QUERY:
+        return Query_Mem_File(req, *files, name);
+
+    case RDC_DELETE:
+        return files->remove(name) ? DR_DONE : Fail(req, ENOENT);
+
+    case RDC_RENAME:
+        return Rename_Mem_File(req, files, name);
+
+    case RDC_CREATE: // i.e. MAKE-DIR, and mounts have no directories
+    default:
+        return Fail(req, ENOSYS);
+    }
+}
+
+} // end anonymous namespace
+
+
+namespace ren {
+
+namespace internal {
+
+void installMemoryFileDevice() {
+    REBDEV *dev = Devices[RDI_FILE];
+    if (Host_File_Cmds)
+        return;
+
+    Host_File_Cmds = dev->commands;
+
+    for (int index = 0; index < RDC_MAX; ++index)
+        Mem_File_Cmds[index] = index < dev->max_command
+            ? Host_File_Cmds[index]
+            : nullptr;
+
+    // Only the commands that are given a path or an open file are taken
+    // over; initialization, shutdown and polling stay with the host's
+    Mem_File_Cmds[RDC_OPEN] = &Mem_File_Command;
+    Mem_File_Cmds[RDC_CLOSE] = &Mem_File_Command;
+    Mem_File_Cmds[RDC_READ] = &Mem_File_Command;
+    Mem_File_Cmds[RDC_WRITE] = &Mem_File_Command;
+    Mem_File_Cmds[RDC_QUERY] = &Mem_File_Command;
+    Mem_File_Cmds[RDC_CREATE] = &Mem_File_Command;
+    Mem_File_Cmds[RDC_DELETE] = &Mem_File_Command;
+    Mem_File_Cmds[RDC_RENAME] = &Mem_File_Command;
+
+    dev->commands = Mem_File_Cmds;
+    if (dev->max_command < RDC_MAX)
+        dev->max_command = RDC_MAX;
+}
+
+} // end namespace internal
+
+} // end namespace ren
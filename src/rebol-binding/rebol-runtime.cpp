@@ -1,5 +1,7 @@
+#include <chrono>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 
 #include <csignal>
 #include <unistd.h>
@@ -192,7 +194,9 @@ RebolRuntime runtime {true};
 
 RebolRuntime::RebolRuntime (bool) :
     Runtime (),
-    initialized (false)
+    initialized (false),
+    timings (),
+    stdioEngine (nullptr)
 {
     Host_Lib = &Host_Lib_Init; // OS host library (dispatch table)
 
@@ -270,6 +274,16 @@ bool RebolRuntime::lazyInitializeIfNecessary() {
     if (initialized)
         return false;
 
+    // Each lap() is the time since the previous one, for startupTimings()
+    auto const started = std::chrono::steady_clock::now();
+    auto lapStart = started;
+    auto lap = [&lapStart]() {
+        auto now = std::chrono::steady_clock::now();
+        auto elapsed = now - lapStart;
+        lapStart = now;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+    };
+
 #ifdef OS_STACK_GROWS_UP
 	Stack_Limit = static_cast<void*>(-1);
 #else
@@ -309,12 +323,19 @@ bool RebolRuntime::lazyInitializeIfNecessary() {
     getcwd(reinterpret_cast<char *>(rebargs.home_dir), MAX_PATH);
 #endif
 
+    lap(); // argument setup only counts toward the total
+
     Init_Core(&rebargs);
+    timings.initCore = lap();
 
     Init_Core_Ext(); // adds to a table used by RL_Start, must be called before
+    timings.initExtensions = lap();
+
+    internal::installMemoryFileDevice();
 
     // Needed to run the SYS_START function
     int err_num = RL_START(0, 0, NULL, 0, 0);
+    timings.startMezzanine = lap();
 
     GC_Active = TRUE; // Turn on GC
 
@@ -351,20 +372,7 @@ bool RebolRuntime::lazyInitializeIfNecessary() {
         );
 
 
-    // bin is optional startup code (compressed).  If it is provided, it
-    // will be stored in system/options/boot-host, loaded, and evaluated.
-
-    REBYTE * startupBin = nullptr;
-    REBCNT len = 0; // length of above bin
-
-    if (startupBin) {
-        REBSER * startup = Decompress(startupBin, len, -1, FALSE, FALSE);
-
-        if (not startup)
-            throw std::runtime_error("RebolHooks: Bad startup code");;
-
-		Val_Init_Binary(BLK_SKIP(Sys_Context, SYS_CTX_BOOT_HOST), startup);
-    }
+    lap();
 
     // RenCpp is based on "generalized apply", e.g. a notion of APPLY
     // that is willing to evaluate expressions and give them to a set-word!
@@ -445,6 +453,11 @@ bool RebolRuntime::lazyInitializeIfNecessary() {
 
     Make_Native(&applyNative, applySpec, applyFun, REB_NATIVE);
     Set_Var(&applyWord, &applyNative);
+    timings.patchApply = lap();
+
+    timings.total = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - started
+    );
 
     initialized = true;
 
@@ -453,6 +466,13 @@ bool RebolRuntime::lazyInitializeIfNecessary() {
 
 
 
+Engine & RebolRuntime::getStdioEngine() {
+    if (not stdioEngine)
+        stdioEngine = &Engine::runFinder();
+    return *stdioEngine;
+}
+
+
 void RebolRuntime::doMagicOnlyRebolCanDo() {
    std::cout << "REBOL MAGIC!\n";
 }
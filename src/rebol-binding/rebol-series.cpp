@@ -1,4 +1,6 @@
 #include <array>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 
 #include "rencpp/value.hpp"
@@ -6,6 +8,8 @@
 #include "rencpp/series.hpp"
 #include "rencpp/arrays.hpp" // For Path evaluation in operator[]
 
+#include "../serialize-cells.hpp"
+
 
 namespace ren {
 
@@ -146,4 +150,75 @@ const {
 }
 
 
+//
+// CELL ACCESS FOR SERIALIZATION
+//
+
+namespace internal {
+
+uintptr_t seriesIdentity(RenCell const & cell) {
+    return reinterpret_cast<uintptr_t>(VAL_SERIES(&cell));
+}
+
+size_t seriesIndex(RenCell const & cell) {
+    return VAL_INDEX(&cell);
+}
+
+void setSeriesIndex(RenCell & cell, size_t index) {
+    VAL_INDEX(&cell) = static_cast<REBCNT>(index);
+}
+
+void initStringCell(
+    RenCell & cell, Kind kind, char const * utf8, size_t size
+) {
+    enum Reb_Kind type;
+    switch (kind) {
+    case Kind::String:
+        type = REB_STRING;
+        break;
+    case Kind::Tag:
+        type = REB_TAG;
+        break;
+    case Kind::Filename:
+        type = REB_FILE;
+        break;
+    default:
+        UNREACHABLE_CODE();
+    }
+
+    // Decodes straight into a new series, no scanning
+    REBSER * series = Append_UTF8(
+        nullptr,
+        reinterpret_cast<REBYTE const *>(utf8),
+        static_cast<REBINT>(size)
+    );
+
+    Val_Init_Series(&cell, type, series);
+}
+
+bool isBinaryCell(RenCell const & cell) {
+    return IS_BINARY(&cell);
+}
+
+string_view binaryCellBytes(RenCell const & cell) {
+    REBSER * series = VAL_SERIES(&cell);
+    return string_view {
+        reinterpret_cast<char const *>(BIN_HEAD(series)), SERIES_TAIL(series)
+    };
+}
+
+void initBinaryCell(RenCell & cell, char const * data, size_t size) {
+    if (size > std::numeric_limits<REBCNT>::max())
+        throw std::length_error {"BINARY! too large"};
+
+    REBSER * series = Make_Binary(static_cast<REBCNT>(size));
+    memcpy(BIN_HEAD(series), data, size);
+    SET_STR_END(series, size);
+    SERIES_TAIL(series) = static_cast<REBCNT>(size);
+
+    Val_Init_Series(&cell, REB_BINARY, series);
+}
+
+} // end namespace internal
+
 } // end namespace ren
@@ -20,6 +20,8 @@
 
 #include "rencpp/rebol.hpp"
 #include "rencpp/engine.hpp"
+#include "rencpp/function.hpp"
+#include "rencpp/input.hpp"
 
 
 #define SF_DEV_NULL 31        // local flag to mark NULL device
@@ -27,6 +29,46 @@
 
 extern REBDEV *Devices[];
 
+extern "C" {
+    // From the host kit's host-device.c
+    void Detach_Request(REBREQ **node, REBREQ *req);
+    void Signal_Device(REBREQ *req, REBINT type);
+}
+
+
+//
+// When the engine has an InputRing, reads take whatever bytes are in it
+// (see input.hpp).  If it's empty they wait, a slice at a time, so that an
+// escape can get through and an Evaluator can run queued jobs.  A halt
+// leaves the read with nothing and the signal set, for the evaluator to
+// act on as soon as the read returns.
+//
+
+static void Take_From_Ring(REBREQ *req, ren::InputRing & ring)
+{
+    req->actual = static_cast<u32>(ring.read(
+        reinterpret_cast<char*>(req->common.data), req->length
+    ));
+}
+
+
+static DEVICE_CMD Read_Ring(REBREQ *req, ren::InputRing & ring)
+{
+    while (true) {
+        Take_From_Ring(req, ring);
+        if (req->actual > 0 or ring.atEnd())
+            return DR_DONE;
+
+        if (GET_SIGNAL(SIG_ESCAPE))
+            return DR_DONE;
+
+        if (ren::internal::whileAwaitingFuture)
+            (*ren::internal::whileAwaitingFuture)();
+
+        ring.waitReadable(ren::internal::futurePollInterval);
+    }
+}
+
 
 
 
@@ -104,7 +146,10 @@ extern REBDEV *Devices[];
         return DR_DONE;
     }
 
-    std::ostream & os = ren::Engine::runFinder().getOutputStream();
+    // The engine buffers the output and decides when to pass it on to the
+    // stream (see OutputPolicy in engine.hpp)
+
+    std::ostream & os = rebol::runtime.getStdioEngine().getBufferedOutput();
 
     os.write(
         reinterpret_cast<char*>(req->common.data),
@@ -121,16 +166,6 @@ extern REBDEV *Devices[];
         return DR_ERROR;
     }
 
-    // For now we flush on every write.  It is inefficient, but it's not
-    // clear what would be done about it otherwise if you are trying to read
-    // the output in a console.  Perhaps an iostream class can be
-    // self-flushing based on a timer, so if it hasn't been flushed for a
-    // second it will?
-
-    //if (GET_FLAG(req->flags, RRF_FLUSH)) {
-        os.flush();
-    //}
-
     // old code could theoretically tell you when you had partial output;
     // that's not really part of the ostream interface for write.  What
     // could you do about partial output to stdout anyway?
@@ -162,7 +197,16 @@ extern REBDEV *Devices[];
 
     req->actual = 0;
 
-    std::istream & is = ren::Engine::runFinder().getInputStream();
+    ren::Engine & engine = rebol::runtime.getStdioEngine();
+
+    // Whatever prompt was printed has to be seen before waiting on input
+    if (engine.getOutputPolicy().flushOnInput)
+        engine.flushOutput();
+
+    if (ren::InputRing * ring = engine.getInputRing())
+        return Read_Ring(req, *ring);
+
+    std::istream & is = engine.getInputStream();
 
     // There is a std::string equivalent for getline that doesn't require
     // a buffer length, but we go with the version that takes a buffer
@@ -185,6 +229,46 @@ extern REBDEV *Devices[];
 }
 
 
+/***********************************************************************
+**
+*/    static DEVICE_CMD Poll_IO(REBREQ *dr)
+/*
+**        Finish pending reads that the input ring can now satisfy, and
+**        signal their ports, so that WAIT on the input port wakes up.
+**
+**        Returns whether any requests were finished.
+**
+***********************************************************************/
+{
+    REBDEV *dev = (REBDEV*)dr; // the poll command is passed the device
+
+    ren::InputRing * ring = rebol::runtime.getStdioEngine().getInputRing();
+    if (not ring)
+        return 0;
+
+    REBINT finished = 0;
+
+    REBREQ *req = dev->pending;
+    while (req) {
+        REBREQ *next = req->next;
+
+        if (
+            req->command == RDC_READ
+            and (ring->available() > 0 or ring->atEnd())
+        ) {
+            Take_From_Ring(req, *ring);
+            Detach_Request(&dev->pending, req);
+            Signal_Device(req, EVT_READ);
+            ++finished;
+        }
+
+        req = next;
+    }
+
+    return finished > 0 ? 1 : 0;
+}
+
+
 /***********************************************************************
 **
 */    static DEVICE_CMD Open_Echo(REBREQ *)
@@ -217,7 +301,7 @@ static DEVICE_CMD_FUNC Dev_Cmds[RDC_MAX] =
     Close_IO,
     Read_IO,
     Write_IO,
-    0,    // poll
+    Poll_IO,
     0,    // connect
     0,    // query
     0,    // modify
@@ -1,4 +1,5 @@
 #include <array>
+#include <cstdint>
 #include <stdexcept>
 #include <vector>
 
@@ -41,6 +42,62 @@ bool AnyValue::isSameAs(AnyValue const & other) const {
 
 
 
+//
+// KIND CLASSIFICATION
+//
+
+internal::Kind AnyValue::kindOf_() const noexcept {
+    using internal::Kind;
+
+    switch (VAL_TYPE(&cell)) {
+    case REB_UNSET: return Kind::Unset;
+    case REB_NONE: return Kind::None;
+    case REB_LOGIC: return Kind::Logic;
+    case REB_CHAR: return Kind::Character;
+    case REB_INTEGER: return Kind::Integer;
+    case REB_DECIMAL: return Kind::Float;
+    case REB_DATE: return Kind::Date;
+    case REB_TIME: return Kind::Time;
+    case REB_PAIR: return Kind::Pair;
+    case REB_TUPLE: return Kind::Tuple;
+
+    case REB_WORD: return Kind::Word;
+    case REB_SET_WORD: return Kind::SetWord;
+    case REB_GET_WORD: return Kind::GetWord;
+    case REB_LIT_WORD: return Kind::LitWord;
+    case REB_REFINEMENT: return Kind::Refinement;
+    case REB_ISSUE: return Kind::Issue;
+
+    case REB_BLOCK: return Kind::Block;
+    case REB_PAREN: return Kind::Group;
+    case REB_PATH: return Kind::Path;
+    case REB_SET_PATH: return Kind::SetPath;
+    case REB_GET_PATH: return Kind::GetPath;
+    case REB_LIT_PATH: return Kind::LitPath;
+
+    case REB_STRING: return Kind::String;
+    case REB_TAG: return Kind::Tag;
+    case REB_FILE: return Kind::Filename;
+    case REB_URL: return Kind::OtherString;
+
+    case REB_OBJECT: return Kind::Context;
+    case REB_ERROR: return Kind::Error;
+    case REB_IMAGE: return Kind::Image;
+
+    default:
+        break;
+    }
+
+    // Must agree with the isXXX() tests (see KindsOf in visit.hpp).  The
+    // strings isAnyString() doesn't take (EMAIL! and such) are Other, but
+    // isFunction() uses the range macro, so this does too.
+    if (ANY_FUNC(&cell))
+        return Kind::Function;
+
+    return Kind::Other;
+}
+
+
 //
 // The only way the client can get handles of types that need some kind of
 // garbage collection participation right now is if the system gives it to
@@ -96,7 +153,33 @@ bool AnyValue::tryFinishInit(RenEngineHandle engine) {
 }
 
 
+bool AnyValue::tryFinishBorrow(RenEngineHandle engine) {
+    assert(not next and not prev);
+
+    assert(engine.data == 1020);
+    origin = engine;
+
+    assert(NOT_END(&cell));
+
+    if (IS_UNSET(&cell))
+        return false;
+
+    // Not linked in, whatever the type; the lender keeps it alive
+    prev = this;
+    return true;
+}
+
+
 void AnyValue::uninitialize() {
+    // A borrowed value was never linked in, so there's nothing to remove
+    // and no need for the mutex.
+
+    if (prev == this) {
+        prev = nullptr;
+        origin = REN_ENGINE_HANDLE_INVALID;
+        return;
+    }
+
 
     // !!! We could avoid taking the mutex if the type wasn't tracked, but we
     // do not pay for initialization of the cell bits.  So this check could
@@ -318,11 +401,28 @@ QString to_QString(AnyValue const & value) {
 namespace internal {
 
 Loadable::Loadable (char const * sourceCstr) :
+    Loadable (string_view {sourceCstr})
+{
+    // The scanner can read this one where it is
+    VAL_INDEX(&cell) |= loadableTerminated;
+}
+
+
+Loadable::Loadable (string_view source) :
     AnyValue (AnyValue::Dont::Initialize)
 {
-    // using REB_END as our "alien"
+    // The scanner takes a REBCNT length, less the bit that marks a NUL
+    if (source.size() >= loadableTerminated)
+        throw std::length_error {"Loadable source text is too long"};
+
+    // using REB_END as our "alien"; it is never seen by the GC, so the
+    // series slots can hold the text and its length (which lets the text
+    // be any slice of a buffer, not just a NUL-terminated one)
     VAL_SET(&cell, REB_END);
-    VAL_HANDLE_DATA(&cell) = const_cast<char *>(sourceCstr);
+    VAL_SERIES(&cell) = reinterpret_cast<REBSER *>(
+        const_cast<char *>(source.data())
+    );
+    VAL_INDEX(&cell) = static_cast<REBCNT>(source.size());
 
     next = nullptr;
     prev = nullptr;
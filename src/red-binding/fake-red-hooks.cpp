@@ -109,7 +109,11 @@ public:
             }
             else {
                 print(
-                    "PENDING:", reinterpret_cast<char*>(cell.data1)
+                    "PENDING:",
+                    std::string {
+                        static_cast<char const *>(cell.dataP),
+                        static_cast<size_t>(cell.data1)
+                    }
                 );
             }
 
@@ -173,12 +177,55 @@ public:
         return REN_SUCCESS;
     }
 
+	RenResult LoadUtf8(
+		RedEngineHandle,
+		RedCell const *,
+		unsigned char const *,
+		size_t,
+		int,
+		RedCell *,
+		RedCell *
+	) {
+		throw std::runtime_error("LoadUtf8...coming soon...");
+	}
+
+	RenResult LimitUsage(
+		RedEngineHandle,
+		uint64_t,
+		uint64_t,
+		uint64_t * evalLimitOut,
+		uint64_t * memoryLimitOut
+	) {
+		// Nothing is counted yet, so only deadlines can be exceeded
+		*evalLimitOut = 0;
+		*memoryLimitOut = 0;
+		return REN_SUCCESS;
+	}
+
+	RenResult RestoreUsageLimits(RedEngineHandle, uint64_t, uint64_t) {
+		return REN_SUCCESS;
+	}
+
+	RenResult ExceedBudget(RedEngineHandle) {
+		// Nothing can interrupt the fake evaluator yet (see ShimHalt)
+		return REN_SUCCESS;
+	}
+
+	RenResult RetractBudget(RedEngineHandle) {
+		return REN_SUCCESS;
+	}
+
 	RenResult ShimHalt() {
 		// Done by setting a signal and then checking in the interpreter
 		// loop in Rebol and doing a longjmp; how will Red do it?
 		throw std::runtime_error("ShimCancel...coming soon...");
 	}
 
+	int ShimHaltRequested() {
+		// Nothing can cancel the fake evaluator yet
+		return 0;
+	}
+
 	void ShimInitThrown(RedCell *, RedCell const *, RedCell const *) {
 		// Presumably Red uses a similar technique to Rebol for throw/catch
 		throw std::runtime_error("ShimInitThrown...coming soon...");
@@ -265,10 +312,64 @@ RenResult RenFormAsUtf8(
 }
 
 
+RenResult RenLimitUsage(
+	RedEngineHandle engine,
+	uint64_t maxEvalSteps,
+	uint64_t maxMemoryBytes,
+	uint64_t * evalLimitOut,
+	uint64_t * memoryLimitOut
+) {
+	return ren::internal::hooks.LimitUsage(
+		engine, maxEvalSteps, maxMemoryBytes, evalLimitOut, memoryLimitOut
+	);
+}
+
+
+RenResult RenRestoreUsageLimits(
+	RedEngineHandle engine,
+	uint64_t evalLimit,
+	uint64_t memoryLimit
+) {
+	return ren::internal::hooks.RestoreUsageLimits(
+		engine, evalLimit, memoryLimit
+	);
+}
+
+
+RenResult RenLoadUtf8(
+	RedEngineHandle engine,
+	RedCell const * context,
+	unsigned char const * utf8,
+	size_t size,
+	int terminated,
+	RedCell * blockOut,
+	RedCell * errorOut
+) {
+	return ren::internal::hooks.LoadUtf8(
+		engine, context, utf8, size, terminated, blockOut, errorOut
+	);
+}
+
+
+RenResult RenExceedBudget(RedEngineHandle engine) {
+	return ren::internal::hooks.ExceedBudget(engine);
+}
+
+
+RenResult RenRetractBudget(RedEngineHandle engine) {
+	return ren::internal::hooks.RetractBudget(engine);
+}
+
+
 RenResult RenShimHalt() {
 	return ren::internal::hooks.ShimHalt();
 }
 
+
+int RenShimHaltRequested() {
+	return ren::internal::hooks.ShimHaltRequested();
+}
+
 void RenShimInitThrown(RedCell *out, RedCell const *value, RedCell const *name) {
 	return ren::internal::hooks.ShimInitThrown(out, value, name);
 }
@@ -107,4 +107,23 @@ AnyArray::AnyArray (
 }
 
 
+AnyArray::AnyArray (
+    AnyValue const values[],
+    size_t numValues,
+    internal::CellFunction cellfun,
+    Context const * contextPtr,
+    Engine * engine
+) :
+    Series (Dont::Initialize)
+{
+    throw std::runtime_error("AnyArray::AnyArray coming soon...");
+
+    UNUSED(values);
+    UNUSED(numValues);
+    UNUSED(cellfun);
+    UNUSED(contextPtr);
+    UNUSED(engine);
+}
+
+
 } // end namespace ren
@@ -19,4 +19,16 @@ bool AnyValue::isError() const {
 }
 
 
+
+///
+/// CONSTRUCTION
+///
+
+Error::Error (const char *, Engine *) :
+    AnyValue (Dont::Initialize)
+{
+    throw std::runtime_error("errors not implemented");
+}
+
+
 } // end namespace ren
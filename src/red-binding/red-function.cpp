@@ -24,4 +24,98 @@ void Function::finishInitSpecial(
 }
 
 
+RenShimPointer Function::getShim() const {
+    throw std::runtime_error("Function::getShim() coming soon...");
+}
+
+
+
+///
+/// CELL CODECS FOR PLAIN C++ TYPES
+///
+
+namespace internal {
+
+int64_t CellCodec<int64_t>::fromCell(RenCell const & cell, RenEngineHandle) {
+    if (RedRuntime::getDatatypeID(cell) != RedRuntime::TYPE_INTEGER)
+        throw std::runtime_error("INTEGER! expected for int64_t argument");
+    return cell.dataII.data2; // Red integers are 32-bit
+}
+
+void CellCodec<int64_t>::toCell(
+    RenCell & cell, int64_t value, RenEngineHandle
+) {
+    if (value < INT32_MIN or value > INT32_MAX)
+        throw std::runtime_error("int64_t too large for Red INTEGER!");
+    cell = RedRuntime::makeCell4I(
+        RedRuntime::TYPE_INTEGER, 0, static_cast<int32_t>(value), 0
+    );
+}
+
+
+int CellCodec<int>::fromCell(RenCell const & cell, RenEngineHandle engine) {
+    return static_cast<int>(CellCodec<int64_t>::fromCell(cell, engine));
+}
+
+void CellCodec<int>::toCell(RenCell & cell, int value, RenEngineHandle) {
+    cell = RedRuntime::makeCell4I(RedRuntime::TYPE_INTEGER, 0, value, 0);
+}
+
+
+double CellCodec<double>::fromCell(RenCell const & cell, RenEngineHandle) {
+    if (RedRuntime::getDatatypeID(cell) == RedRuntime::TYPE_FLOAT)
+        return cell.dataD;
+    if (RedRuntime::getDatatypeID(cell) == RedRuntime::TYPE_INTEGER)
+        return cell.dataII.data2;
+    throw std::runtime_error("FLOAT! expected for double argument");
+}
+
+void CellCodec<double>::toCell(RenCell & cell, double value, RenEngineHandle) {
+    cell = RedRuntime::makeCell2I1D(RedRuntime::TYPE_FLOAT, 0, value);
+}
+
+
+bool CellCodec<bool>::fromCell(RenCell const & cell, RenEngineHandle) {
+    if (RedRuntime::getDatatypeID(cell) != RedRuntime::TYPE_LOGIC)
+        throw std::runtime_error("LOGIC! expected for bool argument");
+    return cell.data1 != 0; // as in AnyValue::isTrue()
+}
+
+void CellCodec<bool>::toCell(RenCell & cell, bool value, RenEngineHandle) {
+    cell = RedRuntime::makeCell4I(RedRuntime::TYPE_LOGIC, value, 0, 0);
+}
+
+
+std::string CellCodec<std::string>::fromCell(
+    RenCell const &, RenEngineHandle
+) {
+    throw std::runtime_error("std::string native arguments coming soon...");
+}
+
+void CellCodec<std::string>::toCell(
+    RenCell &, std::string const &, RenEngineHandle
+) {
+    throw std::runtime_error("std::string native results coming soon...");
+}
+
+
+void initBlockCell(RenCell &, size_t) {
+    throw std::runtime_error("initBlockCell coming soon...");
+}
+
+void appendToBlockCell(RenCell &, RenCell const &) {
+    throw std::runtime_error("appendToBlockCell coming soon...");
+}
+
+size_t blockCellLength(RenCell const &) {
+    throw std::runtime_error("blockCellLength coming soon...");
+}
+
+RenCell const & blockCellAt(RenCell const &, size_t) {
+    throw std::runtime_error("blockCellAt coming soon...");
+}
+
+} // end namespace internal
+
+
 } // end namespace ren
@@ -0,0 +1,92 @@
+#include <stdexcept>
+
+#include "rencpp/value.hpp"
+#include "rencpp/image.hpp"
+
+#include "rencpp/red.hpp"
+
+#define UNUSED(x) static_cast<void>(x)
+
+namespace ren {
+
+//
+// TYPE DETECTION
+//
+
+bool AnyValue::isImage() const {
+    // The fake Red runtime has no image type
+    return false;
+}
+
+
+
+//
+// IMAGE
+//
+
+Image::Image (size_t width, size_t height, Engine * engine) :
+    AnyValue (Dont::Initialize)
+{
+    UNUSED(width);
+    UNUSED(height);
+    UNUSED(engine);
+
+    throw std::runtime_error("Image::Image coming soon...");
+}
+
+
+Image::Image (
+    void const * pixels,
+    size_t width,
+    size_t height,
+    size_t stride,
+    PixelFormat format,
+    Engine * engine
+) :
+    AnyValue (Dont::Initialize)
+{
+    UNUSED(pixels);
+    UNUSED(width);
+    UNUSED(height);
+    UNUSED(stride);
+    UNUSED(format);
+    UNUSED(engine);
+
+    throw std::runtime_error("Image::Image coming soon...");
+}
+
+
+size_t Image::width() const {
+    throw std::runtime_error("Image::width coming soon...");
+}
+
+
+size_t Image::height() const {
+    throw std::runtime_error("Image::height coming soon...");
+}
+
+
+void Image::copyPixelsTo(void *, size_t, PixelFormat) const {
+    throw std::runtime_error("Image::copyPixelsTo coming soon...");
+}
+
+
+PixelSpan Image::pixels() const {
+    throw std::runtime_error("Image::pixels coming soon...");
+}
+
+
+PixelSpan::PixelSpan (PixelSpan && other) :
+    image (other.image),
+    bits (other.bits),
+    w (other.w),
+    h (other.h),
+    pinned (false)
+{
+}
+
+
+PixelSpan::~PixelSpan () {
+}
+
+} // end namespace ren
@@ -78,6 +78,34 @@ bool AnyValue::isCharacter() const {
 }
 
 
+AnyValue::AnyValue (char c, Engine * engine) noexcept :
+    AnyValue (
+        RedRuntime::makeCell4I(RedRuntime::TYPE_CHAR, 0, c, 0),
+        ensureEngine(engine)
+    )
+{
+} // same layout as INTEGER!, with the codepoint where the value is
+
+
+AnyValue::AnyValue (wchar_t wc, Engine * engine) noexcept :
+    AnyValue (
+        RedRuntime::makeCell4I(
+            RedRuntime::TYPE_CHAR, 0, static_cast<int32_t>(wc), 0
+        ),
+        ensureEngine(engine)
+    )
+{
+}
+
+
+Character::Character (int i, Engine * engine) :
+    Atom (Dont::Initialize)
+{
+    cell = RedRuntime::makeCell4I(RedRuntime::TYPE_CHAR, 0, i, 0);
+    finishInit(ensureEngine(engine));
+}
+
+
 Character::operator char() const {
     throw std::runtime_error("Character::operator char() coming soon...");
 }
@@ -88,6 +116,11 @@ Character::operator wchar_t() const {
 }
 
 
+unsigned long Character::codepoint() const {
+    return static_cast<unsigned long>(cell.dataII.data2);
+}
+
+
 
 ///
 /// INTEGER
@@ -136,4 +169,136 @@ Float::operator double () const {
 }
 
 
+
+///
+/// DATE, TIME, PAIR, TUPLE
+///
+
+// The Red runtime has no datatype IDs for these yet (see RedRuntime)
+
+bool AnyValue::isDate() const {
+    return false;
+}
+
+
+bool AnyValue::isTime() const {
+    return false;
+}
+
+
+bool AnyValue::isPair() const {
+    return false;
+}
+
+
+bool AnyValue::isTuple() const {
+    return false;
+}
+
+
+Date::Date (std::chrono::system_clock::time_point when, Engine * engine) :
+    Atom (Dont::Initialize)
+{
+    UNUSED(when);
+    UNUSED(engine);
+
+    throw std::runtime_error("Date::Date coming soon...");
+}
+
+
+Date::Date (int year, int month, int day, Engine * engine) :
+    Atom (Dont::Initialize)
+{
+    UNUSED(year);
+    UNUSED(month);
+    UNUSED(day);
+    UNUSED(engine);
+
+    throw std::runtime_error("Date::Date coming soon...");
+}
+
+
+int Date::year() const {
+    throw std::runtime_error("Date::year coming soon...");
+}
+
+
+int Date::month() const {
+    throw std::runtime_error("Date::month coming soon...");
+}
+
+
+int Date::day() const {
+    throw std::runtime_error("Date::day coming soon...");
+}
+
+
+Date::operator std::chrono::system_clock::time_point () const {
+    throw std::runtime_error("Date::operator time_point coming soon...");
+}
+
+
+Time::Time (std::chrono::nanoseconds duration, Engine * engine) :
+    Atom (Dont::Initialize)
+{
+    UNUSED(duration);
+    UNUSED(engine);
+
+    throw std::runtime_error("Time::Time coming soon...");
+}
+
+
+Time::operator std::chrono::nanoseconds () const {
+    throw std::runtime_error("Time::operator nanoseconds coming soon...");
+}
+
+
+Pair::Pair (double x, double y, Engine * engine) :
+    Atom (Dont::Initialize)
+{
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(engine);
+
+    throw std::runtime_error("Pair::Pair coming soon...");
+}
+
+
+double Pair::x() const {
+    throw std::runtime_error("Pair::x coming soon...");
+}
+
+
+double Pair::y() const {
+    throw std::runtime_error("Pair::y coming soon...");
+}
+
+
+Tuple::Tuple (
+    unsigned char const components[],
+    size_t count,
+    Engine * engine
+) :
+    Atom (Dont::Initialize)
+{
+    UNUSED(components);
+    UNUSED(count);
+    UNUSED(engine);
+
+    throw std::runtime_error("Tuple::Tuple coming soon...");
+}
+
+
+size_t Tuple::size() const {
+    throw std::runtime_error("Tuple::size coming soon...");
+}
+
+
+unsigned char Tuple::operator[](size_t index) const {
+    UNUSED(index);
+
+    throw std::runtime_error("Tuple::operator[] coming soon...");
+}
+
+
 } // end namespace ren
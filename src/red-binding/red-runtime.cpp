@@ -1,5 +1,7 @@
+#include <cstdint>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 
 #ifndef NDEBUG
 #include <map>
@@ -18,12 +20,21 @@ Runtime & runtimeRef = runtime;
 
 
 internal::Loadable::Loadable (char const * sourceCstr) :
+    Loadable (string_view {sourceCstr})
+{
+}
+
+
+internal::Loadable::Loadable (string_view source) :
     AnyValue (AnyValue::Dont::Initialize)
 {
+    if (source.size() > INT32_MAX)
+        throw std::length_error {"Loadable source text is too long"};
+
     cell = RedRuntime::makeCell2I1P(
         RedRuntime::TYPE_ALIEN,
-        0,
-        const_cast<char *>(sourceCstr)
+        static_cast<int32_t>(source.size()),
+        const_cast<char *>(source.data())
     );
     next = prev = nullptr;
     origin = REN_ENGINE_HANDLE_INVALID;
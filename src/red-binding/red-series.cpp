@@ -1,3 +1,5 @@
+#include <stdexcept>
+
 #include "rencpp/value.hpp"
 #include "rencpp/atoms.hpp"
 #include "rencpp/arrays.hpp"
@@ -5,6 +7,8 @@
 
 #include "rencpp/red.hpp"
 
+#include "../serialize-cells.hpp"
+
 #define UNUSED(x) static_cast<void>(x)
 
 namespace ren {
@@ -116,4 +120,40 @@ AnyValue Series::operator[](AnyValue const & index) const {
 }
 
 
+//
+// CELL ACCESS FOR SERIALIZATION
+//
+
+namespace internal {
+
+uintptr_t seriesIdentity(RenCell const &) {
+    throw std::runtime_error("seriesIdentity coming soon...");
+}
+
+size_t seriesIndex(RenCell const &) {
+    throw std::runtime_error("seriesIndex coming soon...");
+}
+
+void setSeriesIndex(RenCell &, size_t) {
+    throw std::runtime_error("setSeriesIndex coming soon...");
+}
+
+void initStringCell(RenCell &, Kind, char const *, size_t) {
+    throw std::runtime_error("initStringCell coming soon...");
+}
+
+bool isBinaryCell(RenCell const &) {
+    throw std::runtime_error("isBinaryCell coming soon...");
+}
+
+string_view binaryCellBytes(RenCell const &) {
+    throw std::runtime_error("binaryCellBytes coming soon...");
+}
+
+void initBinaryCell(RenCell &, char const *, size_t) {
+    throw std::runtime_error("initBinaryCell coming soon...");
+}
+
+} // end namespace internal
+
 } // end namespace ren
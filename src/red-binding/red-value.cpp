@@ -29,6 +29,50 @@ bool AnyValue::isSameAs(AnyValue const & other) const {
 }
 
 
+///
+/// KIND CLASSIFICATION
+///
+
+internal::Kind AnyValue::kindOf_() const noexcept {
+    using internal::Kind;
+
+    switch (RedRuntime::getDatatypeID(this->cell)) {
+    case RedRuntime::TYPE_UNSET: return Kind::Unset;
+    case RedRuntime::TYPE_NONE: return Kind::None;
+    case RedRuntime::TYPE_LOGIC: return Kind::Logic;
+    case RedRuntime::TYPE_CHAR: return Kind::Character;
+    case RedRuntime::TYPE_INTEGER: return Kind::Integer;
+    case RedRuntime::TYPE_FLOAT: return Kind::Float;
+
+    case RedRuntime::TYPE_WORD: return Kind::Word;
+    case RedRuntime::TYPE_SET_WORD: return Kind::SetWord;
+    case RedRuntime::TYPE_GET_WORD: return Kind::GetWord;
+    case RedRuntime::TYPE_LIT_WORD: return Kind::LitWord;
+    case RedRuntime::TYPE_REFINEMENT: return Kind::Refinement;
+    case RedRuntime::TYPE_ISSUE: return Kind::Issue;
+
+    case RedRuntime::TYPE_BLOCK: return Kind::Block;
+    case RedRuntime::TYPE_PAREN: return Kind::Group;
+    case RedRuntime::TYPE_PATH: return Kind::Path;
+    case RedRuntime::TYPE_SET_PATH: return Kind::SetPath;
+    case RedRuntime::TYPE_GET_PATH: return Kind::GetPath;
+    case RedRuntime::TYPE_LIT_PATH: return Kind::LitPath;
+
+    case RedRuntime::TYPE_STRING: return Kind::String;
+    case RedRuntime::TYPE_FILE: return Kind::Filename;
+    case RedRuntime::TYPE_URL: return Kind::OtherString;
+
+    case RedRuntime::TYPE_FUNCTION: return Kind::Function;
+    case RedRuntime::TYPE_OBJECT: return Kind::Context;
+    case RedRuntime::TYPE_ERROR: return Kind::Error;
+
+    default:
+        break;
+    }
+    return Kind::Other;
+}
+
+
 ///
 /// INITIALIZATION FINISHER
 ///
@@ -40,7 +84,29 @@ bool AnyValue::tryFinishInit(RenEngineHandle engine) {
 }
 
 
+bool AnyValue::tryFinishBorrow(RenEngineHandle engine) {
+    origin = engine;
+    if (RedRuntime::getDatatypeID(this->cell) == RedRuntime::TYPE_UNSET)
+        return false;
+    prev = this; // borrowed, see Rebol binding
+    return true;
+}
+
+
+void AnyValue::toCell_(
+    RenCell & cell, optional<AnyValue> const & value
+) noexcept {
+    if (value == nullopt)
+        cell = RedRuntime::makeCell4I(RedRuntime::TYPE_UNSET, 0, 0, 0);
+    else
+        cell = value->cell;
+}
+
+
 void AnyValue::uninitialize() {
+    if (prev == this)
+        prev = nullptr;
+
     // This needs to remove the protections from GC, see Rebol binding.
     // !!! Ultimately Rebol and Red are probably similar enough in needs that
     // the tracking might be moved to the common code.
@@ -102,4 +102,23 @@ AnyWord::AnyWord (
 }
 
 
+AnyWord::AnyWord (AnyWord const & other, internal::CellFunction cellfun) :
+    AnyValue (Dont::Initialize)
+{
+    this->cell = other.cell;
+    (this->*cellfun)(&this->cell);
+    finishInit(other.origin);
+}
+
+
+
+//
+// SPELLING
+//
+
+std::string AnyWord::spellingOf_STD() const {
+    throw std::runtime_error("AnyWord::spellingOf_STD coming soon...");
+}
+
+
 } // end namespace ren
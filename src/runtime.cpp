@@ -16,23 +16,45 @@
 // See http://rencpp.hostilefork.com for more information on this project
 //
 
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "rencpp/runtime.hpp"
 #include "rencpp/context.hpp"
+#include "rencpp/engine.hpp"
+#include "rencpp/error.hpp"
+#include "rencpp/startup.hpp"
+
+#include "mapped-file.hpp"
 
 
 namespace ren {
 
-optional<AnyValue> Runtime::evaluate(
+Result<optional<AnyValue>> Runtime::tryEvaluate(
     internal::Loadable const loadables[],
     size_t numLoadables,
     Context const * contextPtr,
     Engine * engine
 ) {
+    internal::runStartupScripts(engine);
+
     AnyValue result (AnyValue::Dont::Initialize);
 
     Context context = contextPtr ? *contextPtr : Context::current(engine);
 
-    if (AnyValue::constructOrApplyInitialize(
+    // Whatever the evaluation printed is passed on as it returns to the
+    // host, however it returns (see OutputPolicy)
+    struct FlushOutput {
+        Engine & engine;
+        ~FlushOutput () {
+            engine.flushOutput();
+        }
+    } flushOutput {engine ? *engine : Engine::runFinder()};
+
+    auto evaluated = AnyValue::tryConstructOrApplyInitialize(
         context.getEngine(),
         &context,
         nullptr, // no applicand
@@ -40,11 +62,278 @@ optional<AnyValue> Runtime::evaluate(
         numLoadables,
         nullptr, // don't construct
         &result // do apply
-    )) {
-        return result;
+    );
+
+    if (not evaluated)
+        return Result<optional<AnyValue>> {evaluated};
+
+    if (*evaluated)
+        return optional<AnyValue> {result};
+
+    return optional<AnyValue> {nullopt};
+}
+
+
+optional<AnyValue> Runtime::evaluate(
+    internal::Loadable const loadables[],
+    size_t numLoadables,
+    Context const * contextPtr,
+    Engine * engine
+) {
+    return tryEvaluate(loadables, numLoadables, contextPtr, engine).value();
+}
+
+
+
+Block Runtime::loadUtf8(
+    char const * utf8,
+    size_t size,
+    Context const * contextPtr,
+    Engine * engine,
+    bool terminated
+) {
+    Context context = contextPtr ? *contextPtr : Context::current(engine);
+
+    AnyValue result (AnyValue::Dont::Initialize);
+    AnyValue error (AnyValue::Dont::Initialize);
+
+    auto code = ::RenLoadUtf8(
+        context.getEngine(),
+        &context.cell,
+        reinterpret_cast<unsigned char const *>(utf8),
+        size,
+        terminated ? 1 : 0,
+        &result.cell,
+        &error.cell
+    );
+
+    switch (code) {
+    case REN_SUCCESS:
+        result.finishInit(context.getEngine());
+        return static_cast<Block>(result);
+
+    case REN_CONSTRUCT_ERROR:
+        error.finishInit(context.getEngine());
+        throw load_error {static_cast<Error>(error)};
+
+    default:
+        throw std::runtime_error("Unknown error in RenLoadUtf8");
     }
+}
+
+
+Block Runtime::loadFile(
+    std::string const & path,
+    Context const * contextPtr,
+    Engine * engine
+) {
+    // The zero after the mapping is for a scanner that looks for one, as
+    // Rebol's does, so that it can scan the mapping without a copy
+    internal::MappedFile file {path, true};
 
-    return nullopt;
+    return loadUtf8(file.data(), file.size(), contextPtr, engine, true);
+}
+
+
+optional<AnyValue> Runtime::doFile(
+    std::string const & path,
+    Context const * contextPtr,
+    Engine * engine
+) {
+    Block code = loadFile(path, contextPtr, engine);
+
+    internal::Loadable loadables[] = {"do", code};
+    return evaluate(loadables, 2, contextPtr, engine);
+}
+
+
+
+//
+// BUDGET DEADLINES
+//
+
+//
+// Step and memory limits are checked by the evaluator itself as it goes
+// (see RenLimitUsage() in hooks.h), but nothing in it watches the clock.
+// There is one evaluator running at a time, so one thread can see to the
+// deadlines of all evaluations.  Each evaluate() with a deadline pushes a
+// Watch for the duration (they nest as evaluations do), and the watchdog
+// sleeps until the nearest deadline in the chain.  It only ever raises the
+// halt, as Runtime::cancel() would; it doesn't look at the evaluator.
+//
+
+namespace internal {
+
+namespace {
+
+struct Watch {
+    RenEngineHandle engine;
+    std::chrono::steady_clock::time_point deadline;
+    bool exceeded;
+    Watch * outer;
+};
+
+
+class Watchdog {
+private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    Watch * innermost;
+    bool stopping;
+    std::thread thread;
+
+    // Returns when the chain next needs looking at
+    std::chrono::steady_clock::time_point check() {
+        auto now = std::chrono::steady_clock::now();
+        auto wake = std::chrono::steady_clock::time_point::max();
+
+        for (Watch * watch = innermost; watch; watch = watch->outer) {
+            if (watch->exceeded)
+                return wake; // stopping already, wait for it to unwind
+
+            if (now >= watch->deadline) {
+                watch->exceeded = true;
+                RenExceedBudget(watch->engine);
+                return std::chrono::steady_clock::time_point::max();
+            }
+
+            wake = std::min(wake, watch->deadline);
+        }
+
+        return wake;
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock {mutex};
+        while (not stopping) {
+            auto wake = check();
+            if (wake == std::chrono::steady_clock::time_point::max())
+                changed.wait(lock);
+            else
+                changed.wait_until(lock, wake);
+        }
+    }
+
+public:
+    Watchdog () :
+        innermost (nullptr),
+        stopping (false)
+    {
+    }
+
+    void push(Watch & watch) {
+        std::lock_guard<std::mutex> lock {mutex};
+
+        watch.exceeded = false;
+        watch.outer = innermost;
+        innermost = &watch;
+
+        if (not thread.joinable())
+            thread = std::thread {&Watchdog::run, this};
+        changed.notify_one();
+    }
+
+    void pop(Watch & watch) {
+        std::lock_guard<std::mutex> lock {mutex};
+        assert(innermost == &watch);
+
+        // The deadline may have passed after the evaluation was done with,
+        // in which case the halt is still pending and would stop the next
+        // evaluation instead.  (If it did stop this one, it's been taken
+        // and retracting does nothing.)  Holding the lock means check()
+        // can't raise it again in between.
+        if (watch.exceeded)
+            RenRetractBudget(watch.engine);
+
+        innermost = watch.outer;
+        changed.notify_one();
+    }
+
+    bool exceeded(Watch const & watch) {
+        std::lock_guard<std::mutex> lock {mutex};
+        return watch.exceeded;
+    }
+
+    ~Watchdog () {
+        {
+            std::lock_guard<std::mutex> lock {mutex};
+            stopping = true;
+        }
+        changed.notify_one();
+        if (thread.joinable())
+            thread.join();
+    }
+};
+
+Watchdog & watchdog() {
+    static Watchdog instance;
+    return instance;
+}
+
+} // end anonymous namespace
+
+} // end namespace internal
+
+
+optional<AnyValue> Runtime::evaluate(
+    std::initializer_list<internal::Loadable> loadables,
+    Budget const & budget,
+    Engine * engine
+) {
+    RenEngineHandle handle
+        = (engine ? *engine : Engine::runFinder()).getHandle();
+
+    // Set and put back on this thread, the one doing the evaluating
+    struct Limits {
+        RenEngineHandle engine;
+        uint64_t evalLimit;
+        uint64_t memoryLimit;
+        Limits (RenEngineHandle engine, Budget const & budget) :
+            engine (engine)
+        {
+            RenLimitUsage(
+                engine,
+                budget.maxEvalSteps,
+                budget.maxMemoryBytes,
+                &evalLimit,
+                &memoryLimit
+            );
+        }
+        ~Limits () {
+            RenRestoreUsageLimits(engine, evalLimit, memoryLimit);
+        }
+    } limits {handle, budget};
+
+    if (budget.deadline.time_since_epoch().count() == 0)
+        return evaluate(loadables.begin(), loadables.size(), nullptr, engine);
+
+    internal::Watch watch;
+    watch.engine = handle;
+    watch.deadline = budget.deadline;
+
+    struct Scope {
+        internal::Watch & watch;
+        Scope (internal::Watch & watch) : watch (watch) {
+            internal::watchdog().push(watch);
+        }
+        ~Scope () {
+            internal::watchdog().pop(watch);
+        }
+    } scope {watch};
+
+    try {
+        return evaluate(loadables.begin(), loadables.size(), nullptr, engine);
+    }
+    catch (budget_exceeded const &) {
+        throw;
+    }
+    catch (evaluation_halt const &) {
+        // The halt may have been taken by a nested evaluation on the way
+        // out (such as one made by a native), losing what it was for
+        if (not internal::watchdog().exceeded(watch))
+            throw;
+        throw budget_exceeded {BudgetLimit::Deadline};
+    }
 }
 
 }
@@ -0,0 +1,64 @@
+#ifndef RENCPP_SERIALIZE_CELLS_HPP
+#define RENCPP_SERIALIZE_CELLS_HPP
+
+//
+// serialize-cells.hpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <cstddef>
+#include <cstdint>
+
+#include "rencpp/value.hpp"
+
+
+namespace ren {
+
+namespace internal {
+
+//
+// The little bit of series access that serialize() needs beyond the cell
+// codecs in function.hpp, implemented by each binding.  Cells passed in
+// must be ANY-SERIES! values.
+//
+
+// The same for every value that is a position in the same series
+uintptr_t seriesIdentity(RenCell const & cell);
+
+size_t seriesIndex(RenCell const & cell);
+
+void setSeriesIndex(RenCell & cell, size_t index);
+
+// A new series of the string kind given (String, Tag or Filename), decoded
+// straight from the UTF-8
+void initStringCell(
+    RenCell & cell, Kind kind, char const * utf8, size_t size
+);
+
+// BINARY! has no class (it is Kind::Other), so it is told apart here.  The
+// bytes are from the head, and only good for as long as the series is.
+bool isBinaryCell(RenCell const & cell);
+
+string_view binaryCellBytes(RenCell const & cell);
+
+// A new BINARY! with a copy of the bytes
+void initBinaryCell(RenCell & cell, char const * data, size_t size);
+
+} // end namespace internal
+
+} // end namespace ren
+
+#endif
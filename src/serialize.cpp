@@ -0,0 +1,644 @@
+//
+// serialize.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include "rencpp/ren.hpp"
+#include "rencpp/serialize.hpp"
+
+#ifdef REN_RUNTIME
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "serialize-cells.hpp"
+
+
+namespace ren {
+
+namespace internal {
+
+//
+// The codes are the format's own numbering, kept apart from internal::Kind
+// so that reordering the kinds doesn't change what is written
+//
+
+enum class Code : unsigned char {
+    None = 1,
+    False,
+    True,
+    Character,
+    Integer,
+    Float,
+
+    Word,
+    SetWord,
+    GetWord,
+    LitWord,
+    Refinement,
+
+    Block,
+    Group,
+    Path,
+    SetPath,
+    GetPath,
+    LitPath,
+
+    String,
+    Tag,
+    Filename,
+    Binary,
+
+    Molded
+};
+
+
+static Code codeOfSeries(Kind kind) {
+    switch (kind) {
+    case Kind::Block: return Code::Block;
+    case Kind::Group: return Code::Group;
+    case Kind::Path: return Code::Path;
+    case Kind::SetPath: return Code::SetPath;
+    case Kind::GetPath: return Code::GetPath;
+    case Kind::LitPath: return Code::LitPath;
+    case Kind::String: return Code::String;
+    case Kind::Tag: return Code::Tag;
+    case Kind::Filename: return Code::Filename;
+    default:
+        UNREACHABLE_CODE();
+    }
+}
+
+
+static char const magic[3] = {'R', 'E', 'N'};
+
+
+
+//
+// WRITING
+//
+
+class Serializer {
+private:
+    std::ostream & sink;
+    RenEngineHandle engine;
+
+    std::unordered_map<std::string, uint32_t> symbols;
+    std::unordered_map<uintptr_t, uint32_t> series;
+    std::unordered_set<uintptr_t> unfinished; // being written, for cycles
+
+private:
+    void writeBytes(char const * data, size_t size) {
+        sink.write(data, static_cast<std::streamsize>(size));
+    }
+
+    void writeCode(Code code) {
+        sink.put(static_cast<char>(code));
+    }
+
+    void writeU32(uint32_t value) {
+        char bytes[4];
+        for (size_t index = 0; index < 4; ++index)
+            bytes[index] = static_cast<char>((value >> (8 * index)) & 0xFF);
+        writeBytes(bytes, 4);
+    }
+
+    void writeU64(uint64_t value) {
+        char bytes[8];
+        for (size_t index = 0; index < 8; ++index)
+            bytes[index] = static_cast<char>((value >> (8 * index)) & 0xFF);
+        writeBytes(bytes, 8);
+    }
+
+    void writeSize(size_t size) {
+        if (size > std::numeric_limits<uint32_t>::max())
+            throw serialization_error {"Series too large to serialize"};
+        writeU32(static_cast<uint32_t>(size));
+    }
+
+    void writeText(std::string const & text) {
+        writeSize(text.size());
+        writeBytes(text.data(), text.size());
+    }
+
+    void writeSymbol(std::string const & spelling) {
+        auto found = symbols.find(spelling);
+        if (found != symbols.end()) {
+            writeU32(found->second);
+            return;
+        }
+
+        auto number = static_cast<uint32_t>(symbols.size());
+        symbols.emplace(spelling, number);
+        writeU32(number);
+        writeText(spelling);
+    }
+
+    void writeSeries(AnyValue const & value, Code code) {
+        writeCode(code);
+
+        uintptr_t id = seriesIdentity(value.cell);
+
+        auto found = series.find(id);
+        if (found != series.end()) {
+            if (unfinished.count(id) != 0)
+                throw serialization_error {
+                    "A series that contains itself can't be serialized"
+                };
+            writeU32(found->second);
+        }
+        else {
+            auto number = static_cast<uint32_t>(series.size());
+            series.emplace(id, number);
+            writeU32(number);
+
+            RenCell head = value.cell;
+            setSeriesIndex(head, 0);
+
+            if (code == Code::Binary) {
+                string_view bytes = binaryCellBytes(head);
+                writeSize(bytes.size());
+                writeBytes(bytes.data(), bytes.size());
+            }
+            else if (code >= Code::String) {
+                writeText(CellCodec<std::string>::fromCell(head, engine));
+            }
+            else {
+                unfinished.insert(id);
+
+                // The items are kept alive by the value being written, so
+                // they can be looked at without being tracked
+                size_t length = blockCellLength(head);
+                writeSize(length);
+                for (size_t index = 0; index < length; ++index)
+                    writeValue(AnyValue::borrowCell_<AnyValue>(
+                        blockCellAt(head, index), engine
+                    ));
+
+                unfinished.erase(id);
+            }
+        }
+
+        writeSize(seriesIndex(value.cell));
+    }
+
+    void writeMolded(AnyValue const & value) {
+        // MOLD/ONLY of a block around the value, so it isn't evaluated
+        writeCode(Code::Molded);
+        writeText(to_string(*runtime("mold/all/only", Block {value})));
+    }
+
+public:
+    Serializer (std::ostream & sink, RenEngineHandle engine) :
+        sink (sink),
+        engine (engine)
+    {
+    }
+
+    void writeHeader() {
+        writeBytes(magic, 3);
+        sink.put(static_cast<char>(serialization_version));
+    }
+
+    void writeValue(AnyValue const & value) {
+        Kind kind = value.kindOf_();
+
+        switch (kind) {
+        case Kind::None:
+            writeCode(Code::None);
+            break;
+
+        case Kind::Logic:
+            writeCode(
+                CellCodec<bool>::fromCell(value.cell, engine)
+                    ? Code::True
+                    : Code::False
+            );
+            break;
+
+        case Kind::Character:
+            writeCode(Code::Character);
+            writeU32(static_cast<uint32_t>(
+                AnyValue::borrowCell_<Character>(value.cell, engine).codepoint()
+            ));
+            break;
+
+        case Kind::Integer:
+            writeCode(Code::Integer);
+            writeU64(static_cast<uint64_t>(
+                CellCodec<int64_t>::fromCell(value.cell, engine)
+            ));
+            break;
+
+        case Kind::Float: {
+            double number = CellCodec<double>::fromCell(value.cell, engine);
+            uint64_t bits;
+            static_assert(sizeof(bits) == sizeof(number), "double not 64-bit");
+            std::memcpy(&bits, &number, sizeof(bits));
+
+            writeCode(Code::Float);
+            writeU64(bits);
+            break;
+        }
+
+        case Kind::Word:
+        case Kind::SetWord:
+        case Kind::GetWord:
+        case Kind::LitWord:
+        case Kind::Refinement:
+            writeCode(static_cast<Code>(
+                static_cast<int>(Code::Word)
+                + (static_cast<int>(kind) - static_cast<int>(Kind::Word))
+            ));
+            writeSymbol(
+                AnyValue::borrowCell_<AnyWord>(value.cell, engine)
+                    .spellingOf_STD()
+            );
+            break;
+
+        case Kind::Block:
+        case Kind::Group:
+        case Kind::Path:
+        case Kind::SetPath:
+        case Kind::GetPath:
+        case Kind::LitPath:
+        case Kind::String:
+        case Kind::Tag:
+        case Kind::Filename:
+            writeSeries(value, codeOfSeries(kind));
+            break;
+
+        case Kind::Function:
+            throw serialization_error {"Functions can't be serialized"};
+
+        case Kind::Other:
+            if (isBinaryCell(value.cell))
+                writeSeries(value, Code::Binary);
+            else
+                writeMolded(value);
+            break;
+
+        case Kind::Unset:
+        case Kind::Date:
+        case Kind::Time:
+        case Kind::Pair:
+        case Kind::Tuple:
+        case Kind::Issue:
+        case Kind::OtherString:
+        case Kind::Context:
+        case Kind::Error:
+        case Kind::Image:
+            writeMolded(value);
+            break;
+
+        default:
+            UNREACHABLE_CODE();
+        }
+    }
+};
+
+
+
+//
+// READING
+//
+
+//
+// Gives out the bytes of the serialized data a run at a time.  A run is
+// only good until the next is taken.
+//
+
+class ByteSource {
+public:
+    virtual char const * take(size_t size) = 0;
+
+    virtual ~ByteSource () {
+    }
+};
+
+
+class BufferSource : public ByteSource {
+private:
+    string_view buffer;
+    size_t position;
+
+public:
+    explicit BufferSource (string_view buffer) :
+        buffer (buffer),
+        position (0)
+    {
+    }
+
+    // Straight out of the buffer, so the payloads aren't copied to be read
+    char const * take(size_t size) override {
+        if (size > buffer.size() - position)
+            throw serialization_error {"Serialized data ends early"};
+        char const * result = buffer.data() + position;
+        position += size;
+        return result;
+    }
+
+    bool atEnd() const {
+        return position == buffer.size();
+    }
+};
+
+
+class StreamSource : public ByteSource {
+private:
+    std::istream & input;
+    std::string scratch;
+
+public:
+    explicit StreamSource (std::istream & input) :
+        input (input)
+    {
+    }
+
+    char const * take(size_t size) override {
+        // Grown as the bytes actually arrive, so a bad size in truncated
+        // data doesn't get a huge allocation
+        scratch.clear();
+        size_t const chunk = 64 * 1024;
+        while (scratch.size() < size) {
+            size_t start = scratch.size();
+            size_t want = std::min(chunk, size - start);
+            scratch.resize(start + want);
+            input.read(&scratch[start], static_cast<std::streamsize>(want));
+            if (static_cast<size_t>(input.gcount()) != want)
+                throw serialization_error {"Serialized data ends early"};
+        }
+        return scratch.data();
+    }
+};
+
+
+class Deserializer {
+private:
+    ByteSource & source;
+    Engine * engine;
+
+    std::vector<Word> symbols;
+
+    // A series is nullopt while its content is still being read
+    std::vector<optional<AnyValue>> series;
+
+private:
+    uint32_t readU32() {
+        auto bytes = reinterpret_cast<unsigned char const *>(source.take(4));
+        uint32_t value = 0;
+        for (size_t index = 0; index < 4; ++index)
+            value |= static_cast<uint32_t>(bytes[index]) << (8 * index);
+        return value;
+    }
+
+    uint64_t readU64() {
+        auto bytes = reinterpret_cast<unsigned char const *>(source.take(8));
+        uint64_t value = 0;
+        for (size_t index = 0; index < 8; ++index)
+            value |= static_cast<uint64_t>(bytes[index]) << (8 * index);
+        return value;
+    }
+
+    Word const & readSymbol() {
+        uint32_t number = readU32();
+        if (number < symbols.size())
+            return symbols[number];
+
+        if (number != symbols.size())
+            throw serialization_error {"Bad symbol number in serialized data"};
+
+        uint32_t size = readU32();
+        std::string spelling {source.take(size), size};
+        symbols.push_back(Word {spelling, engine});
+        return symbols.back();
+    }
+
+    AnyValue readArrayContent(Code code) {
+        uint32_t count = readU32();
+
+        std::vector<AnyValue> items;
+        items.reserve(std::min<size_t>(count, 4096));
+        for (uint32_t index = 0; index < count; ++index)
+            items.push_back(readValue());
+
+        AnyValue const * values = items.data();
+
+        // Not {} construction, which would take these as a list of loadables
+        switch (code) {
+        case Code::Block: return Block (values, items.size(), engine);
+        case Code::Group: return Group (values, items.size(), engine);
+        case Code::Path: return Path (values, items.size(), engine);
+        case Code::SetPath: return SetPath (values, items.size(), engine);
+        case Code::GetPath: return GetPath (values, items.size(), engine);
+        case Code::LitPath: return LitPath (values, items.size(), engine);
+        default:
+            UNREACHABLE_CODE();
+        }
+    }
+
+    AnyValue readStringContent(Code code) {
+        uint32_t size = readU32();
+        char const * utf8 = source.take(size);
+
+        Kind kind = code == Code::String
+            ? Kind::String
+            : code == Code::Tag ? Kind::Tag : Kind::Filename;
+
+        RenCell cell;
+        initStringCell(cell, kind, utf8, size);
+        return AnyValue::fromCell_<AnyValue>(cell, engine->getHandle());
+    }
+
+    AnyValue readBinaryContent() {
+        uint32_t size = readU32();
+        char const * data = source.take(size);
+
+        RenCell cell;
+        initBinaryCell(cell, data, size);
+        return AnyValue::fromCell_<AnyValue>(cell, engine->getHandle());
+    }
+
+    AnyValue readSeries(Code code) {
+        uint32_t number = readU32();
+
+        if (number == series.size()) {
+            // Series inside this one are added while its content is read
+            series.push_back(nullopt);
+            AnyValue content = code == Code::Binary
+                ? readBinaryContent()
+                : code >= Code::String
+                    ? readStringContent(code)
+                    : readArrayContent(code);
+            series[number] = content;
+        }
+        else if (number > series.size() or series[number] == nullopt)
+            throw serialization_error {"Bad series number in serialized data"};
+
+        AnyValue const & head = *series[number];
+
+        uint32_t index = readU32();
+        if (index == 0)
+            return head;
+
+        size_t length = code == Code::Binary
+            ? binaryCellBytes(head.cell).size()
+            : static_cast<Series const &>(head).length();
+        if (index > length)
+            throw serialization_error {"Bad series index in serialized data"};
+
+        RenCell cell;
+        AnyValue::toCell_(cell, head);
+        setSeriesIndex(cell, index);
+        return AnyValue::fromCell_<AnyValue>(cell, engine->getHandle());
+    }
+
+    AnyValue readMolded() {
+        uint32_t size = readU32();
+        char const * text = source.take(size);
+
+        Block loaded = Runtime::loadUtf8(text, size, nullptr, engine);
+        if (loaded.length() != 1)
+            throw serialization_error {"Bad molded value in serialized data"};
+        return loaded[1];
+    }
+
+public:
+    Deserializer (ByteSource & source, Engine * engine) :
+        source (source),
+        engine (engine ? engine : &Engine::runFinder())
+    {
+    }
+
+    void readHeader() {
+        char const * header = source.take(4);
+        if (std::memcmp(header, magic, 3) != 0)
+            throw serialization_error {"Not serialized ren data"};
+
+        auto version = static_cast<unsigned char>(header[3]);
+        if (version != serialization_version)
+            throw serialization_error {
+                "Unsupported serialization version "
+                + std::to_string(static_cast<int>(version))
+            };
+    }
+
+    AnyValue readValue() {
+        auto code = static_cast<Code>(*source.take(1));
+
+        switch (code) {
+        case Code::None:
+            return None {engine};
+
+        case Code::False:
+        case Code::True:
+            return Logic {code == Code::True, engine};
+
+        case Code::Character:
+            return Character {static_cast<int>(readU32()), engine};
+
+        case Code::Integer: {
+            RenCell cell;
+            CellCodec<int64_t>::toCell(
+                cell, static_cast<int64_t>(readU64()), engine->getHandle()
+            );
+            return AnyValue::fromCell_<AnyValue>(cell, engine->getHandle());
+        }
+
+        case Code::Float: {
+            uint64_t bits = readU64();
+            double number;
+            std::memcpy(&number, &bits, sizeof(number));
+            return Float {number, engine};
+        }
+
+        case Code::Word:
+            return readSymbol();
+        case Code::SetWord:
+            return SetWord {readSymbol()};
+        case Code::GetWord:
+            return GetWord {readSymbol()};
+        case Code::LitWord:
+            return LitWord {readSymbol()};
+        case Code::Refinement:
+            return Refinement {readSymbol()};
+
+        case Code::Block:
+        case Code::Group:
+        case Code::Path:
+        case Code::SetPath:
+        case Code::GetPath:
+        case Code::LitPath:
+        case Code::String:
+        case Code::Tag:
+        case Code::Filename:
+        case Code::Binary:
+            return readSeries(code);
+
+        case Code::Molded:
+            return readMolded();
+
+        default:
+            throw serialization_error {"Bad code in serialized data"};
+        }
+    }
+};
+
+} // end namespace internal
+
+
+
+void serialize(AnyValue const & value, std::ostream & sink) {
+    internal::Serializer serializer {sink, Engine::runFinder().getHandle()};
+    serializer.writeHeader();
+    serializer.writeValue(value);
+}
+
+
+std::string serialize(AnyValue const & value) {
+    std::ostringstream sink;
+    serialize(value, sink);
+    return sink.str();
+}
+
+
+AnyValue deserialize(std::istream & source, Engine * engine) {
+    internal::StreamSource bytes {source};
+    internal::Deserializer deserializer {bytes, engine};
+    deserializer.readHeader();
+    return deserializer.readValue();
+}
+
+
+AnyValue deserialize(string_view buffer, Engine * engine) {
+    internal::BufferSource bytes {buffer};
+    internal::Deserializer deserializer {bytes, engine};
+    deserializer.readHeader();
+    AnyValue result = deserializer.readValue();
+
+    if (not bytes.atEnd())
+        throw serialization_error {"Extra bytes after serialized value"};
+    return result;
+}
+
+} // end namespace ren
+
+#endif
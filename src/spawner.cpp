@@ -0,0 +1,269 @@
+//
+// spawner.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#ifndef _WIN32
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "spawner.hpp"
+
+
+namespace ren {
+
+namespace internal {
+
+// Linux reports a write to a closed socket with EPIPE if asked to; elsewhere
+// the socket itself is marked when it is made (see makeSocketPair)
+
+#ifdef MSG_NOSIGNAL
+    static int const sendFlags = MSG_NOSIGNAL;
+#else
+    static int const sendFlags = 0;
+#endif
+
+
+static bool makeSocketPair(int fds[2]) {
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+        return false;
+
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+    int on = 1;
+    setsockopt(fds[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+    setsockopt(fds[1], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+    return true;
+}
+
+
+static bool sendAll(int fd, char const * data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = send(fd, data, size, sendFlags);
+        if (sent < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+
+static bool receiveAll(int fd, char * data, size_t size) {
+    while (size > 0) {
+        ssize_t received = recv(fd, data, size, 0);
+        if (received < 0 and errno == EINTR)
+            continue;
+        if (received <= 0)
+            return false;
+        data += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+
+bool writeFrame(int fd, std::string const & data) {
+    if (data.size() > UINT32_MAX)
+        return false;
+
+    auto length = static_cast<uint32_t>(data.size());
+    return sendAll(fd, reinterpret_cast<char const *>(&length), sizeof(length))
+        and sendAll(fd, data.data(), data.size());
+}
+
+
+bool readFrame(int fd, std::string & data) {
+    uint32_t length;
+    if (not receiveAll(fd, reinterpret_cast<char *>(&length), sizeof(length)))
+        return false;
+
+    data.resize(length);
+    return length == 0 or receiveAll(fd, &data[0], length);
+}
+
+
+//
+// The spawner answers each request with a message carrying the new child's
+// pid, and the host's end of its socket as ancillary data.  A pid of -1
+// (with no descriptor) means the fork failed.
+//
+
+static bool sendChild(int control, pid_t pid, int fd) {
+    iovec part;
+    part.iov_base = &pid;
+    part.iov_len = sizeof(pid);
+
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov = &part;
+    message.msg_iovlen = 1;
+
+    alignas(cmsghdr) char buffer[CMSG_SPACE(sizeof(int))];
+    if (fd >= 0) {
+        std::memset(buffer, 0, sizeof(buffer));
+        message.msg_control = buffer;
+        message.msg_controllen = sizeof(buffer);
+
+        cmsghdr * header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(header), &fd, sizeof(int));
+    }
+
+    return sendmsg(control, &message, sendFlags)
+        == static_cast<ssize_t>(sizeof(pid));
+}
+
+
+static bool receiveChild(int control, SpawnedProcess & child) {
+    iovec part;
+    part.iov_base = &child.pid;
+    part.iov_len = sizeof(child.pid);
+
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov = &part;
+    message.msg_iovlen = 1;
+
+    alignas(cmsghdr) char buffer[CMSG_SPACE(sizeof(int))];
+    message.msg_control = buffer;
+    message.msg_controllen = sizeof(buffer);
+
+    ssize_t received;
+    do {
+        received = recvmsg(control, &message, 0);
+    } while (received < 0 and errno == EINTR);
+
+    if (received != static_cast<ssize_t>(sizeof(child.pid)))
+        return false;
+
+    child.fd = -1;
+    cmsghdr * header = CMSG_FIRSTHDR(&message);
+    if (header and header->cmsg_type == SCM_RIGHTS)
+        std::memcpy(&child.fd, CMSG_DATA(header), sizeof(int));
+
+    return child.pid > 0 and child.fd >= 0;
+}
+
+
+[[noreturn]] static void runSpawner(int control, Spawner::Body const & body) {
+    // Nobody waits on the children, so have them reaped automatically
+    signal(SIGCHLD, SIG_IGN);
+
+    char request;
+    while (receiveAll(control, &request, 1)) {
+        int fds[2];
+        if (not makeSocketPair(fds)) {
+            if (not sendChild(control, -1, -1))
+                break;
+            continue;
+        }
+
+        pid_t child = fork();
+        if (child == 0) {
+            close(control);
+            close(fds[0]);
+            signal(SIGCHLD, SIG_DFL);
+
+            int status = 0;
+            try {
+                body(fds[1]);
+            }
+            catch (...) {
+                status = 1;
+            }
+
+            // Don't run the host's atexit handlers or static destructors
+            _exit(status);
+        }
+
+        close(fds[1]);
+        bool sent = sendChild(control, child, child > 0 ? fds[0] : -1);
+        close(fds[0]);
+
+        if (not sent)
+            break;
+    }
+
+    _exit(0);
+}
+
+
+Spawner::Spawner (Body const & body) {
+    int fds[2];
+    if (not makeSocketPair(fds))
+        throw std::runtime_error("ren::Spawner could not create a socket");
+
+    pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        throw std::runtime_error("ren::Spawner could not fork");
+    }
+
+    if (pid == 0) {
+        close(fds[0]);
+        runSpawner(fds[1], body);
+    }
+
+    close(fds[1]);
+    control = fds[0];
+}
+
+
+SpawnedProcess Spawner::spawn() {
+    std::lock_guard<std::mutex> lock {mutex};
+
+    char request = 0;
+    SpawnedProcess child;
+    if (
+        not sendAll(control, &request, 1)
+        or not receiveChild(control, child)
+    ) {
+        throw std::runtime_error("ren::Spawner could not start a process");
+    }
+
+    return child;
+}
+
+
+Spawner::~Spawner () {
+    // The spawner leaves when its socket closes; children it has made
+    // outlive it until their own sockets close
+
+    close(control);
+    while (waitpid(pid, nullptr, 0) < 0 and errno == EINTR)
+        continue;
+}
+
+} // end namespace internal
+
+} // end namespace ren
+
+#endif
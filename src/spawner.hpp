@@ -0,0 +1,101 @@
+#ifndef RENCPP_SPAWNER_HPP
+#define RENCPP_SPAWNER_HPP
+
+//
+// spawner.hpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+//
+// Internal support for running ren code in child processes (POSIX only).
+// This is not an installed header.
+//
+
+#ifndef _WIN32
+
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include <sys/types.h>
+
+
+namespace ren {
+
+namespace internal {
+
+//
+// A frame is a native-order uint32_t byte count followed by that many
+// bytes.  Both ends are always on the same machine.  These return false if
+// the other end has gone away (or sends something malformed); they do not
+// raise SIGPIPE.
+//
+
+bool writeFrame(int fd, std::string const & data);
+
+bool readFrame(int fd, std::string & data);
+
+
+//
+// Forking the host process to get a new child is only well-defined while
+// the host has a single thread, and the child gets whatever state the
+// runtime was in at the time.  So a Spawner forks once, when constructed,
+// to leave behind a small single-threaded process whose only job is to
+// fork again on request.  Every child comes from that same snapshot, no
+// matter what the host is doing (or how many threads it has) by then.
+//
+// The body runs in the child on its end of a socket, and the child exits
+// when the body returns.  spawn() gives back the child's pid and the
+// host's end of the socket, which the caller owns.  Children are not the
+// host's children, so they can't be waited on; closing the socket (or
+// killing the pid) is how they are gotten rid of, and the spawner reaps
+// them.
+//
+
+struct SpawnedProcess {
+    pid_t pid;
+    int fd;
+};
+
+
+class Spawner {
+public:
+    using Body = std::function<void (int fd)>;
+
+private:
+    std::mutex mutex;
+    pid_t pid;
+    int control;
+
+public:
+    explicit Spawner (Body const & body);
+
+    Spawner (Spawner const &) = delete;
+    Spawner & operator= (Spawner const &) = delete;
+
+    // Throws std::runtime_error if a child could not be made
+    SpawnedProcess spawn();
+
+    ~Spawner ();
+};
+
+} // end namespace internal
+
+} // end namespace ren
+
+#endif
+
+#endif
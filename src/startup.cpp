@@ -0,0 +1,121 @@
+//
+// startup.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rencpp/ren.hpp"
+#include "rencpp/serialize.hpp"
+#include "rencpp/startup.hpp"
+
+
+namespace ren {
+
+namespace {
+
+// Registrations usually come from static initializers, so the list has to
+// be constructed on first use rather than being a global itself
+
+struct StartupScripts {
+    std::mutex mutex;
+    std::vector<internal::StartupScriptEntry> entries;
+
+    // Checked by every evaluation, so it's kept apart from the lock
+    std::atomic<bool> taken {false};
+};
+
+StartupScripts & startupScripts() {
+    static StartupScripts scripts;
+    return scripts;
+}
+
+
+void addEntry(internal::StartupScriptEntry const & entry) {
+    auto & scripts = startupScripts();
+    std::lock_guard<std::mutex> lock {scripts.mutex};
+
+    if (scripts.taken)
+        throw std::runtime_error(
+            std::string {"Startup script "} + entry.name
+            + " registered after the runtime started"
+        );
+
+    scripts.entries.push_back(entry);
+}
+
+} // end anonymous namespace
+
+
+void addStartupScript(char const * name, char const * source) {
+    addEntry(internal::StartupScriptEntry {name, source, 0});
+}
+
+
+void addStartupScript(
+    char const * name, unsigned char const * serialized, size_t size
+) {
+    addEntry(internal::StartupScriptEntry {
+        name, reinterpret_cast<char const *>(serialized), size
+    });
+}
+
+
+namespace internal {
+
+void runStartupScripts(Engine * engine) {
+    auto & scripts = startupScripts();
+    if (scripts.taken.load(std::memory_order_acquire))
+        return;
+
+    // Taken before any are run, as running them evaluates and gets here
+    std::vector<StartupScriptEntry> entries;
+    {
+        std::lock_guard<std::mutex> lock {scripts.mutex};
+        if (scripts.taken)
+            return;
+        scripts.taken = true;
+        entries = std::move(scripts.entries);
+    }
+
+    for (auto const & script : entries) {
+        try {
+            if (script.size == 0) {
+                Runtime::evaluate({script.data}, engine);
+                continue;
+            }
+
+            AnyValue code = deserialize(
+                string_view {script.data, script.size}, engine
+            );
+            Runtime::evaluate({"do", code}, engine);
+        }
+        catch (std::exception const & e) {
+            throw std::runtime_error(
+                std::string {"Startup script "} + script.name + " failed: "
+                + e.what()
+            );
+        }
+    }
+}
+
+} // end namespace internal
+
+} // end namespace ren
@@ -25,10 +25,15 @@
 #include "rencpp/context.hpp"
 #include "rencpp/runtime.hpp"
 #include "rencpp/error.hpp"
+#include "rencpp/result.hpp"
 #include "rencpp/strings.hpp"
 
 namespace ren {
 
+namespace internal {
+    thread_local std::shared_ptr<WhatHome> whatHome;
+}
+
 
 
 // Even if asked not to initialize, we can't leave the type in a state where
@@ -54,7 +59,7 @@ AnyValue::operator bool() const {
 // GENERALIZED APPLY
 //
 
-optional<AnyValue> AnyValue::apply_(
+Result<optional<AnyValue>> AnyValue::tryApply_(
     internal::Loadable const loadables[],
     size_t numLoadables,
     Context const * contextPtr,
@@ -64,7 +69,7 @@ optional<AnyValue> AnyValue::apply_(
 
     Context context = contextPtr ? *contextPtr : Context::current(engine);
 
-    if (constructOrApplyInitialize(
+    auto applied = tryConstructOrApplyInitialize(
         context.getEngine(),
         &context,
         this, // no applicand
@@ -72,20 +77,35 @@ optional<AnyValue> AnyValue::apply_(
         numLoadables,
         nullptr, // don't construct
         &result // do apply
-    )) {
-        return result;
-    }
+    );
+
+    if (not applied)
+        return Result<optional<AnyValue>> {applied};
+
+    if (*applied)
+        return optional<AnyValue> {result};
 
-    return nullopt;
+    return optional<AnyValue> {nullopt};
 }
 
 
+optional<AnyValue> AnyValue::apply_(
+    internal::Loadable const loadables[],
+    size_t numLoadables,
+    Context const * contextPtr,
+    Engine * engine
+) const {
+    return tryApply_(loadables, numLoadables, contextPtr, engine).value();
+}
+
+
+// These have to be in the implementation file because they appear in
+// AnyValue, using Loadable, which is derived from AnyValue...
+
 optional<AnyValue> AnyValue::apply(
     std::initializer_list<internal::Loadable> loadables,
     internal::ContextWrapper const & wrapper
 ) const {
-    // This one has to be in the implementation file because it appears in
-    // AnyValue, using Loadable, which is derived from AnyValue...
     return apply_(
         loadables.begin(),
         loadables.size(),
@@ -99,11 +119,30 @@ optional<AnyValue> AnyValue::apply(
     std::initializer_list<internal::Loadable> loadables,
     Engine * engine
 ) const {
-    // This one has to be in the implementation file because it appears in
-    // AnyValue, using Loadable, which is derived from AnyValue...
     return apply_(loadables.begin(), loadables.size(), nullptr, engine);
 }
 
+
+Result<optional<AnyValue>> AnyValue::tryApply(
+    std::initializer_list<internal::Loadable> loadables,
+    internal::ContextWrapper const & wrapper
+) const {
+    return tryApply_(
+        loadables.begin(),
+        loadables.size(),
+        &wrapper.context,
+        nullptr
+    );
+}
+
+
+Result<optional<AnyValue>> AnyValue::tryApply(
+    std::initializer_list<internal::Loadable> loadables,
+    Engine * engine
+) const {
+    return tryApply_(loadables.begin(), loadables.size(), nullptr, engine);
+}
+
 #endif
 
 
@@ -116,6 +155,29 @@ bool AnyValue::constructOrApplyInitialize(
     AnyValue * constructOutTypeIn,
     AnyValue * applyOut
 ) {
+    return tryConstructOrApplyInitialize(
+        engine,
+        context,
+        applicand,
+        loadables,
+        numLoadables,
+        constructOutTypeIn,
+        applyOut
+    ).value();
+}
+
+
+Result<bool> AnyValue::tryConstructOrApplyInitialize(
+    RenEngineHandle engine,
+    Context const * context,
+    AnyValue const * applicand,
+    internal::Loadable const loadables[],
+    size_t numLoadables,
+    AnyValue * constructOutTypeIn,
+    AnyValue * applyOut
+) {
+    using internal::ResultBase;
+
     AnyValue extraOut {AnyValue::Dont::Initialize};
 
     auto result = ::RenConstructOrApply(
@@ -137,24 +199,40 @@ bool AnyValue::constructOrApplyInitialize(
         case REN_CONSTRUCT_ERROR:
             extraOut.finishInit(engine);
             assert(extraOut.isError());
-            throw load_error {static_cast<Error>(extraOut)};
+            return Result<bool> {
+                ResultBase {Failure::LoadError, extraOut}
+            };
 
     #ifdef REN_RUNTIME
         case REN_APPLY_ERROR: {
             extraOut->finishInit(engine);
             assert(extraOut->isError());
-            throw evaluation_error {static_cast<Error>(extraOut)};
+            return Result<bool> {
+                ResultBase {Failure::EvaluationError, extraOut}
+            };
         }
 
 		case REN_EVALUATION_HALTED:
 			throw evaluation_halt {};
 
+		case REN_BUDGET_EXCEEDED:
+			throw budget_exceeded {BudgetLimit::Deadline};
+
+		case REN_EVAL_STEPS_EXCEEDED:
+			throw budget_exceeded {BudgetLimit::EvalSteps};
+
+		case REN_MEMORY_EXCEEDED:
+			throw budget_exceeded {BudgetLimit::MemoryBytes};
+
 		case REN_APPLY_THREW: {
             bool hasName = applyOut->tryFinishInit(engine);
             bool hasValue = extraOut->tryFinishInit(engine);
-            throw evaluation_throw {
-                hasValue ? optional<AnyValue>{extraOut} : nullopt,
-                hasName ? optional<AnyValue>{*applyOut} : nullopt
+            return Result<bool> {
+                ResultBase {
+                    Failure::Throw,
+                    hasValue ? optional<AnyValue>{extraOut} : nullopt,
+                    hasName ? optional<AnyValue>{*applyOut} : nullopt
+                }
             };
 		}
     #endif
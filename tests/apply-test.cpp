@@ -24,6 +24,18 @@ TEST_CASE("apply test", "[rebol] [apply]")
         );
     }
 
+    SECTION("failure message")
+    {
+        auto failed = SetWord {"w"}.tryApply({10, 20});
+        REQUIRE(failed.failure() == Failure::EvaluationError);
+
+        // The message is made when asked for, once for all the copies
+        evaluation_error error {failed.error()};
+        evaluation_error copy = error;
+        CHECK(std::string {copy.what()} != "");
+        CHECK(error.what() == copy.what());
+    }
+
     SECTION("none failure")
     {
         // technical note: explicit none(arg1, arg2...) is now illegal
@@ -34,4 +46,40 @@ TEST_CASE("apply test", "[rebol] [apply]")
             evaluation_error
         );
     }
+
+    SECTION("try apply")
+    {
+        auto applied = SetWord {"w"}.tryApply({10});
+        REQUIRE(applied);
+        REQUIRE(*applied);
+        CHECK(static_cast<int>(static_cast<Integer>(**applied)) == 10);
+
+        AnyValue value = none;
+        auto failed = value.tryApply({10});
+        CHECK(not failed);
+        CHECK(failed.failure() == Failure::EvaluationError);
+        CHECK(failed.error().isError());
+        CHECK_THROWS_AS(failed.value(), evaluation_error);
+    }
+
+    SECTION("try evaluate")
+    {
+        auto raised = runtime.tryEvaluate({"do make error! {Hedgehog}"});
+        CHECK(raised.failure() == Failure::EvaluationError);
+
+        auto thrown = runtime.tryEvaluate({"throw/name 10 'hedgehog"});
+        REQUIRE(thrown.failure() == Failure::Throw);
+        CHECK(thrown.thrownValue()->isEqualTo(10));
+        CHECK(thrown.throwName()->isEqualTo(LitWord {"hedgehog"}));
+        CHECK_THROWS_AS(thrown.rethrow(), evaluation_throw);
+        CHECK_THROWS_AS(thrown.error(), std::logic_error);
+
+        auto unloadable = runtime.tryEvaluate({"{Hedgehog"});
+        CHECK(unloadable.failure() == Failure::LoadError);
+        CHECK_THROWS_AS(unloadable.value(), load_error);
+
+        auto evaluated = runtime.tryEvaluate({"1 + 2"});
+        REQUIRE(evaluated);
+        CHECK(static_cast<int>(static_cast<Integer>(**evaluated)) == 3);
+    }
 }
@@ -53,4 +53,18 @@ TEST_CASE("block test", "[rebol] [block]")
         CHECK(blk2[1].isLogic());
         CHECK(blk2[2].isInteger());
     }
+
+    SECTION("string view")
+    {
+        // Loading a slice of a buffer, without a terminator after it
+        char const buffer[] = "[1 2] 3 [4 5] no-terminator-here";
+
+        string_view slice {buffer + 6, 7};
+        Block block {slice};
+
+        CHECK(block.isEqualTo(Block {"3 [4 5]"}));
+
+        Block mixed {1, string_view {buffer + 1, 3}, 4};
+        CHECK(mixed.isEqualTo(Block {"1 1 2 4"}));
+    }
 }
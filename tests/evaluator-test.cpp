@@ -0,0 +1,153 @@
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rencpp/ren.hpp"
+
+using namespace ren;
+
+#include "catch.hpp"
+
+TEST_CASE("evaluator test", "[rebol] [evaluator]")
+{
+    Evaluator evaluator;
+
+    CHECK_THROWS_AS(Evaluator {}, std::runtime_error);
+
+    SECTION("submit from many threads")
+    {
+        std::vector<std::future<optional<AnyValue>>> results (40);
+        std::vector<std::thread> submitters;
+
+        for (size_t offset = 0; offset < 4; ++offset)
+            submitters.emplace_back([&evaluator, &results, offset]() {
+                for (size_t index = offset; index < 40; index += 4)
+                    results[index] = evaluator.submit(
+                        std::to_string(index) + " * 2"
+                    );
+            });
+
+        for (auto & submitter : submitters)
+            submitter.join();
+
+        for (size_t index = 0; index < 40; ++index) {
+            auto result = results[index].get();
+            int doubled = evaluator.post([&result]() {
+                return static_cast<int>(static_cast<Integer>(*result));
+            }).get();
+            CHECK(doubled == static_cast<int>(index * 2));
+        }
+    }
+
+    SECTION("errors come out of the future")
+    {
+        auto failed = evaluator.submit("1 / 0");
+        CHECK_THROWS_AS(failed.get(), evaluation_error);
+
+        // The message is molded by the evaluator when it is asked for here
+        try {
+            evaluator.submit("1 / 0").get();
+            FAIL("no evaluation_error");
+        }
+        catch (evaluation_error const & e) {
+            CHECK(std::string {e.what()} != "ren::evaluation_error");
+        }
+
+        CHECK(evaluator.post([&evaluator]() {
+            return evaluator.isEvaluatorThread();
+        }).get());
+        CHECK(not evaluator.isEvaluatorThread());
+    }
+
+    SECTION("jobs run while a native waits")
+    {
+        std::promise<int> release;
+        auto released = release.get_future().share();
+
+        auto waiting = evaluator.post([released]() {
+            auto wait = Function::construct(
+                "",
+
+                REN_STD_FUNCTION,
+
+                [released]() {
+                    return std::async(std::launch::async, [released]() {
+                        return static_cast<int64_t>(released.get());
+                    });
+                }
+            );
+            return static_cast<int>(static_cast<Integer>(*wait()));
+        });
+
+        // This one is queued behind the waiting native, yet finishes first
+        auto other = evaluator.post([&release]() {
+            release.set_value(7);
+            return true;
+        });
+
+        CHECK(other.get());
+        CHECK(waiting.get() == 7);
+    }
+
+    SECTION("jobs run nested still go in the order submitted")
+    {
+        std::vector<int> order; // only touched on the evaluator's thread
+
+        std::promise<void> started;
+        auto waitStarted = started.get_future();
+        std::promise<int> release;
+        auto released = release.get_future().share();
+
+        auto waiting = evaluator.post([&order, &started, released]() {
+            auto wait = Function::construct(
+                "",
+
+                REN_STD_FUNCTION,
+
+                [&started, released]() {
+                    started.set_value();
+                    return std::async(std::launch::async, [released]() {
+                        return static_cast<int64_t>(released.get());
+                    });
+                }
+            );
+            int result = static_cast<int>(static_cast<Integer>(*wait()));
+            order.push_back(0);
+            return result;
+        });
+
+        // Likely taken in the same batch as the waiting job
+        auto first = evaluator.post([&order]() { order.push_back(1); });
+        auto second = evaluator.post([&order]() { order.push_back(2); });
+
+        // Certainly submitted while it waits (if it got that far)
+        CHECK(
+            waitStarted.wait_for(std::chrono::seconds {10})
+            == std::future_status::ready
+        );
+        auto third = evaluator.post([&order, &release]() {
+            order.push_back(3);
+            release.set_value(7);
+        });
+
+        CHECK(waiting.get() == 7);
+        first.get();
+        second.get();
+        third.get();
+        CHECK(order == (std::vector<int> {1, 2, 3, 0}));
+    }
+
+    SECTION("submit a block")
+    {
+        auto sum = evaluator.post([&evaluator]() {
+            return evaluator.submit(Block {"10 + 20"});
+        }).get();
+        auto result = sum.get();
+
+        CHECK(evaluator.post([&result]() {
+            return static_cast<int>(static_cast<Integer>(*result));
+        }).get() == 30);
+    }
+}
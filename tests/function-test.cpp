@@ -1,5 +1,10 @@
+#include <chrono>
+#include <future>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "rencpp/ren.hpp"
 
@@ -44,3 +49,169 @@ TEST_CASE("function test", "[rebol] [function]")
 
     CHECK(static_cast<Integer>(*runtime("10 +", addFive, 100)) == 115);
 }
+
+
+namespace {
+
+Integer addInts(Integer const & a, Integer const & b) {
+    return a + b;
+}
+
+} // end anonymous namespace
+
+
+TEST_CASE("direct function test", "[rebol] [function]")
+{
+    SECTION("lambda")
+    {
+        auto subtract = [](Integer const & a, Integer const & b) -> Integer {
+            return a - b;
+        };
+
+        REN_CHECK_FUNCTION_ARITY(
+            "{Subtract with no std::function}"
+            "a [integer!] {Minuend} b [integer!] {Subtrahend}",
+            subtract
+        );
+
+        auto subtractFn = Function::construct(
+            "{Subtract with no std::function}"
+            "a [integer!] {Minuend} b [integer!] {Subtrahend}",
+            subtract
+        );
+
+        CHECK(static_cast<Integer>(*subtractFn(20, 3)) == 17);
+    }
+
+    SECTION("function pointer")
+    {
+        REN_CHECK_FUNCTION_ARITY("a [integer!] b [integer!]", addInts);
+
+        auto addFn = Function::construct<decltype(&addInts), &addInts>(
+            "a [integer!] b [integer!]"
+        );
+
+        CHECK(static_cast<Integer>(*runtime(addFn, 10, 20)) == 30);
+    }
+
+    SECTION("borrowed arguments")
+    {
+        std::vector<Block> kept;
+
+        auto keep = Function::construct(
+            "blk [block!]",
+
+            REN_STD_FUNCTION,
+
+            [&kept](ArgRef<Block> blk) -> Integer {
+                kept.push_back(blk); // promoted to a tracked value here
+                return blk.length();
+            }
+        );
+
+        CHECK(static_cast<Integer>(*keep(Block {"1 2 3"})) == 3);
+
+        runtime("recycle");
+
+        REQUIRE(kept.size() == 1);
+        CHECK(kept[0].length() == 3);
+    }
+
+    SECTION("plain C++ types")
+    {
+        auto scale = Function::construct(
+            "a [integer!] b [decimal!]",
+            [](int64_t a, double b) -> double { return a * b; }
+        );
+
+        CHECK(static_cast<Float>(*scale(2, 1.5)) == 3.0);
+
+        auto join = Function::construct(
+            "items [block!] reverse [logic!]",
+            [](std::vector<std::string> const & items, bool reverse) {
+                std::string result;
+                for (auto const & item : items)
+                    result = reverse ? item + result : result + item;
+                return result;
+            }
+        );
+
+        CHECK(to_string(*join(Block {"{ab} {cd}"}, false)) == "abcd");
+        CHECK(to_string(*join(Block {"{ab} {cd}"}, true)) == "cdab");
+
+        auto wrongType = Function::construct(
+            "value [number!]",
+            [](int64_t value) { return value; }
+        );
+
+        CHECK_THROWS_AS(wrongType(1.5), evaluation_error);
+    }
+
+    SECTION("release and reuse")
+    {
+        // The same REN_STD_FUNCTION site is reused on each pass, getting a
+        // fresh callable once the previous registration is released
+
+        for (int offset = 0; offset < 3; ++offset) {
+            auto addOffset = Function::construct(
+                "value [integer!]",
+
+                REN_STD_FUNCTION,
+
+                [offset](Integer const & value) -> Integer {
+                    return value + offset;
+                }
+            );
+
+            CHECK(static_cast<Integer>(*addOffset(10)) == 10 + offset);
+
+            CHECK(addOffset.release());
+            CHECK_THROWS_AS(addOffset(10), evaluation_error);
+        }
+    }
+
+    SECTION("future results")
+    {
+        auto later = Function::construct(
+            "value [integer!]",
+            [](int64_t value) {
+                return std::async(std::launch::async, [value]() {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+                    return value * 2;
+                });
+            }
+        );
+
+        CHECK(static_cast<Integer>(*later(21)) == 42);
+
+        auto failing = Function::construct(
+            "value [integer!]",
+            [](int64_t) {
+                return std::async(std::launch::deferred, []() -> int64_t {
+                    throw Error {"failed in the future"};
+                });
+            }
+        );
+
+        CHECK_THROWS_AS(failing(1), evaluation_error);
+    }
+
+    SECTION("spec arity")
+    {
+        static_assert(internal::specArity("") == 0, "empty spec");
+        static_assert(
+            internal::specArity("{doc} ; comment [x]\n 'a [block!] :b /c d")
+                == 4,
+            "words, refinements, and refinement arguments take slots"
+        );
+
+        // Checked again when constructed, for specs not given as literals
+        CHECK_THROWS_AS(
+            Function::construct(
+                Block {"a [integer!] b [integer!]"},
+                [](int64_t a) { return a; }
+            ),
+            std::invalid_argument
+        );
+    }
+}
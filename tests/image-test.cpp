@@ -0,0 +1,155 @@
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "rencpp/ren.hpp"
+
+using namespace ren;
+
+#include "catch.hpp"
+
+namespace {
+
+// The conversion one pixel at a time, written out plainly, for checking the
+// vectorized one against
+
+void convertReference(
+    unsigned char const * from,
+    PixelFormat fromFormat,
+    unsigned char * to,
+    PixelFormat toFormat
+) {
+    auto swapped = [](PixelFormat format) {
+        return format == PixelFormat::BGRA8
+            or format == PixelFormat::BGRA8Premultiplied;
+    };
+    auto premultiplied = [](PixelFormat format) {
+        return format == PixelFormat::RGBA8Premultiplied
+            or format == PixelFormat::BGRA8Premultiplied;
+    };
+
+    unsigned int a = from[3];
+    unsigned int channels[3] = {from[0], from[1], from[2]};
+
+    for (unsigned int & c : channels) {
+        if (premultiplied(toFormat) and not premultiplied(fromFormat))
+            c = (c * a + 127) / 255;
+        else if (premultiplied(fromFormat) and not premultiplied(toFormat)) {
+            c = a == 0 ? 0 : (c * 255 + a / 2) / a;
+            if (c > 255)
+                c = 255;
+        }
+    }
+
+    if (swapped(fromFormat) != swapped(toFormat))
+        std::swap(channels[0], channels[2]);
+
+    for (size_t index = 0; index < 3; ++index)
+        to[index] = static_cast<unsigned char>(channels[index]);
+    to[3] = static_cast<unsigned char>(a);
+}
+
+} // end anonymous namespace
+
+
+TEST_CASE("image test", "[rebol] [image]")
+{
+    // 2x2, rows padded to 12 bytes
+    std::vector<unsigned char> rgba {
+        255, 0, 0, 255,     0, 255, 0, 128,     0xEE, 0xEE, 0xEE, 0xEE,
+        0, 0, 255, 0,       10, 20, 30, 255,    0xEE, 0xEE, 0xEE, 0xEE
+    };
+
+    SECTION("conversion")
+    {
+        unsigned char pixel[4] = {200, 100, 50, 128};
+
+        convertPixels(pixel, PixelFormat::RGBA8, pixel, PixelFormat::BGRA8, 1);
+        CHECK(pixel[0] == 50);
+        CHECK(pixel[2] == 200);
+
+        convertPixels(
+            pixel, PixelFormat::BGRA8,
+            pixel, PixelFormat::RGBA8Premultiplied,
+            1
+        );
+        CHECK(pixel[0] == 100);
+        CHECK(pixel[1] == 50);
+        CHECK(pixel[2] == 25);
+        CHECK(pixel[3] == 128);
+    }
+
+    SECTION("conversion against a reference")
+    {
+        // 4n + 3 pixels, so that the vector loops run and leave some over
+        size_t const count = 4 * 64 + 3;
+
+        std::vector<unsigned char> source (4 * count);
+        uint32_t seed = 1020;
+        for (auto & byte : source) {
+            seed = seed * 1103515245u + 12345u;
+            byte = static_cast<unsigned char>(seed >> 16);
+        }
+        source[3] = 0; // transparent, and opaque, among the rest
+        source[7] = 255;
+
+        PixelFormat const formats[] = {
+            PixelFormat::RGBA8,
+            PixelFormat::BGRA8,
+            PixelFormat::RGBA8Premultiplied,
+            PixelFormat::BGRA8Premultiplied
+        };
+
+        for (PixelFormat fromFormat : formats) {
+            for (PixelFormat toFormat : formats) {
+                std::vector<unsigned char> expected (4 * count);
+                for (size_t index = 0; index < count; ++index)
+                    convertReference(
+                        &source[4 * index], fromFormat,
+                        &expected[4 * index], toFormat
+                    );
+
+                std::vector<unsigned char> converted (4 * count);
+                convertPixels(
+                    source.data(), fromFormat,
+                    converted.data(), toFormat,
+                    count
+                );
+                CHECK(converted == expected);
+
+                std::vector<unsigned char> inPlace = source;
+                convertPixels(
+                    inPlace.data(), fromFormat,
+                    inPlace.data(), toFormat,
+                    count
+                );
+                CHECK(inPlace == expected);
+            }
+        }
+    }
+
+    SECTION("buffers")
+    {
+        Image image {rgba.data(), 2, 2, 12, PixelFormat::RGBA8};
+
+        CHECK(image.isImage());
+        CHECK(image.width() == 2);
+        CHECK(image.height() == 2);
+
+        // 0xAARRGGBB words in the runtime's own layout
+        auto span = image.pixels();
+        CHECK(span.size() == 4);
+        CHECK(span.row(0)[0] == 0xFFFF0000u);
+        CHECK(span.row(1)[1] == 0xFF0A141Eu);
+
+        span.row(0)[0] = 0xFF00FF00u;
+        CHECK_THROWS(runtime("clear", image));
+
+        std::vector<unsigned char> out (16);
+        image.copyPixelsTo(out.data(), 8, PixelFormat::RGBA8);
+        CHECK(out[0] == 0);
+        CHECK(out[1] == 255);
+        CHECK(out[12] == 10);
+        CHECK(out[15] == 255);
+    }
+}
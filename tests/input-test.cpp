@@ -0,0 +1,64 @@
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "rencpp/ren.hpp"
+
+using namespace ren;
+
+#include "catch.hpp"
+
+TEST_CASE("input ring test", "[input]")
+{
+    SECTION("partial and multi-line")
+    {
+        InputRing ring {8};
+        CHECK(ring.capacity() == 8);
+
+        CHECK(ring.write("ab\ncd\nefgh") == 8); // only what fits
+        CHECK(ring.available() == 8);
+
+        char buffer[16];
+        CHECK(ring.read(buffer, 4) == 4);
+        CHECK(std::string(buffer, 4) == "ab\nc");
+
+        // Wraps around the end
+        CHECK(ring.write("XYZ") == 3);
+        CHECK(ring.read(buffer, sizeof(buffer)) == 7);
+        CHECK(std::string(buffer, 7) == "d\nefXYZ");
+
+        CHECK(not ring.atEnd());
+        ring.close();
+        CHECK(ring.atEnd());
+        CHECK(ring.waitReadable(std::chrono::milliseconds {0}));
+    }
+
+    SECTION("across threads")
+    {
+        InputRing ring {64};
+
+        std::string sent;
+        for (int index = 0; index < 10000; ++index)
+            sent += std::to_string(index) + "\n";
+
+        std::thread writer {[&]() {
+            size_t done = 0;
+            while (done < sent.size()) {
+                size_t chunk = std::min<size_t>(sent.size() - done, 37);
+                done += ring.write(sent.data() + done, chunk);
+            }
+            ring.close();
+        }};
+
+        std::string received;
+        char buffer[50];
+        while (not ring.atEnd()) {
+            if (ring.available() == 0)
+                ring.waitReadable(std::chrono::milliseconds {10});
+            received.append(buffer, ring.read(buffer, sizeof(buffer)));
+        }
+        writer.join();
+
+        CHECK(received == sent);
+    }
+}
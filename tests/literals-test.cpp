@@ -59,6 +59,70 @@ TEST_CASE("literals construction", "[rebol] [literals]")
     }
 
 
+    SECTION("date construction")
+    {
+        using namespace std::chrono;
+
+        // 2015-03-14T01:59:26Z
+        system_clock::time_point when {seconds {1426298366}};
+
+        Date date {when};
+        CHECK(date.isDate());
+        CHECK(date.year() == 2015);
+        CHECK(date.month() == 3);
+        CHECK(date.day() == 14);
+        CHECK(static_cast<system_clock::time_point>(date) == when);
+
+        Date leap {2016, 2, 29};
+        CHECK(leap.day() == 29);
+        CHECK(
+            static_cast<system_clock::time_point>(leap).time_since_epoch()
+            == hours {24 * 16860}
+        );
+
+        CHECK_THROWS_AS(Date(2015, 2, 29), std::out_of_range);
+        CHECK_THROWS_AS(Date(2015, 13, 1), std::out_of_range);
+    }
+
+
+    SECTION("time construction")
+    {
+        using namespace std::chrono;
+
+        Time time {hours {25} + milliseconds {500}};
+        CHECK(time.isTime());
+        CHECK(
+            static_cast<nanoseconds>(time) == hours {25} + milliseconds {500}
+        );
+
+        Time negative {seconds {-90}};
+        CHECK(duration_cast<seconds>(nanoseconds {negative}).count() == -90);
+    }
+
+
+    SECTION("pair construction")
+    {
+        Pair pair {640, -480.5};
+        CHECK(pair.isPair());
+        CHECK(pair.x() == 640);
+        CHECK(pair.y() == -480.5);
+    }
+
+
+    SECTION("tuple construction")
+    {
+        Tuple tuple {255, 0, 127, 3};
+        CHECK(tuple.isTuple());
+        CHECK(tuple.size() == 4);
+        CHECK(tuple[1] == 255);
+        CHECK(tuple[4] == 3);
+        CHECK_THROWS_AS(tuple[5], std::out_of_range);
+        CHECK_THROWS_AS(tuple[0], std::out_of_range);
+
+        CHECK_THROWS_AS(Tuple({1, 2}), std::length_error);
+    }
+
+
     SECTION("string construction")
     {
         String value {"Hello"};
@@ -0,0 +1,132 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rencpp/ren.hpp"
+#include "rencpp/loader.hpp"
+
+using namespace ren;
+
+#include "catch.hpp"
+
+// Feeds the text a few bytes at a time, so values straddle the pieces
+
+static std::vector<std::string> split(
+    std::string const & text,
+    bool unwrap,
+    size_t pieceSize
+) {
+    internal::ValueSplitter splitter {unwrap};
+    std::vector<std::string> out;
+    for (size_t index = 0; index < text.size(); index += pieceSize)
+        splitter.feed(
+            text.data() + index,
+            std::min(pieceSize, text.size() - index),
+            out
+        );
+    splitter.finish(out);
+    return out;
+}
+
+
+TEST_CASE("stream loader test", "[loader]")
+{
+    SECTION("splitting")
+    {
+        std::string text =
+            "[\n"
+            "    [a 1] ; comment with [ and \"\n"
+            "    {braced ] {nested} ^} text} \"quoted ^\" ]\"\n"
+            "    #[none] [1 2][3 4] a/(b)/c\n"
+            "]\n";
+
+        std::vector<std::string> expected {
+            "[a 1]",
+            "{braced ] {nested} ^} text}",
+            "\"quoted ^\" ]\"",
+            "#[none]",
+            "[1 2]",
+            "[3 4]",
+            "a/(b)/c"
+        };
+
+        for (size_t pieceSize : std::vector<size_t> {1, 3, 7, 1000})
+            CHECK(split(text, true, pieceSize) == expected);
+
+        // Without unwrapping, the whole block is one value
+        CHECK(split(text, false, 5).size() == 1);
+
+        // Items are given out as they close, not when the block does
+        internal::ValueSplitter streaming {true};
+        std::vector<std::string> out;
+        std::string opened = "[1 [2] 3";
+        streaming.feed(opened.data(), opened.size(), out);
+        CHECK(out == (std::vector<std::string> {"1", "[2]"}));
+        streaming.finish(out);
+        CHECK(out == (std::vector<std::string> {"1", "[2]", "3"}));
+        CHECK(streaming.malformed() != nullptr);
+
+        // Only comments can follow the wrapping block
+        for (size_t pieceSize : std::vector<size_t> {1, 3, 1000}) {
+            CHECK(
+                split("[1 2] ; trailing comment\n", true, pieceSize)
+                == (std::vector<std::string> {"1", "2"})
+            );
+
+            internal::ValueSplitter trailing {true};
+            out.clear();
+            std::string text = "[1 2] 3 4";
+            for (size_t index = 0; index < text.size(); index += pieceSize)
+                trailing.feed(
+                    text.data() + index,
+                    std::min(pieceSize, text.size() - index),
+                    out
+                );
+            trailing.finish(out);
+            CHECK(out == (std::vector<std::string> {"1", "2"}));
+            CHECK(trailing.malformed() != nullptr);
+        }
+
+        // Without unwrapping, blocks side by side are separate values
+        CHECK(
+            split("[1 2][3 4]", false, 1)
+            == (std::vector<std::string> {"[1 2]", "[3 4]"})
+        );
+
+        // A comment inside a block still separates the values around it
+        CHECK(
+            split("[[a;c\nb]]", true, 1)
+            == (std::vector<std::string> {"[a b]"})
+        );
+    }
+
+    SECTION("loading")
+    {
+        std::stringstream records;
+        records << "[";
+        for (int index = 0; index < 1000; ++index)
+            records << " [id " << index << "]";
+        records << "]";
+
+        StreamLoader loader {records, true, 16};
+
+        int count = 0;
+        while (auto record = loader.next()) {
+            Block block = static_cast<Block>(*record);
+            CHECK(static_cast<Integer>(block[2]) == count);
+            ++count;
+        }
+        CHECK(count == 1000);
+
+        std::stringstream broken {"1 [2"};
+        StreamLoader brokenLoader {broken};
+        CHECK(static_cast<Integer>(*brokenLoader.next()) == 1);
+        CHECK_THROWS_AS(brokenLoader.next(), load_error);
+
+        std::stringstream trailing {"[1 2] 3"};
+        StreamLoader trailingLoader {trailing};
+        CHECK(static_cast<Integer>(*trailingLoader.next()) == 1);
+        CHECK(static_cast<Integer>(*trailingLoader.next()) == 2);
+        CHECK_THROWS_AS(trailingLoader.next(), load_error);
+    }
+}
@@ -0,0 +1,60 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "rencpp/ren.hpp"
+#include "rencpp/memfs.hpp"
+
+using namespace ren;
+
+#include "catch.hpp"
+
+TEST_CASE("memory files test", "[memfs]")
+{
+    auto files = std::make_shared<MemoryFiles>();
+    files->add("notes.txt", "hello");
+
+    static char const fixed[] = "read only";
+    files->addView("fixed.txt", fixed, sizeof(fixed) - 1);
+
+    SECTION("reading and writing")
+    {
+        char buffer[16];
+        CHECK(files->read("notes.txt", 1, buffer, sizeof(buffer)) == 4);
+        CHECK(std::string(buffer, 4) == "ello");
+
+        CHECK(files->open("notes.txt", true, false));
+        CHECK(files->write("notes.txt", 5, " world", 6));
+        CHECK(*files->get("notes.txt") == std::vector<char>(
+            {'h', 'e', 'l', 'l', 'o', ' ', 'w', 'o', 'r', 'l', 'd'}
+        ));
+
+        // Views can't be opened for writing, and new names are created
+        CHECK(not files->open("fixed.txt", true, false));
+        CHECK(not files->open("missing.txt", false, false));
+        CHECK(files->open("new.txt", true, true));
+        CHECK(files->names().size() == 3);
+
+        CHECK(files->rename("new.txt", "renamed.txt"));
+        CHECK(files->get("new.txt") == nullopt);
+        CHECK(files->remove("renamed.txt"));
+
+        CHECK_THROWS_AS(
+            files->addMapped("nowhere", "/nonexistent/rencpp-test"),
+            std::runtime_error
+        );
+    }
+
+    SECTION("mounts")
+    {
+        mountFiles("/mem", files);
+
+        std::string name;
+        CHECK(internal::findMountedFiles("/mem/notes.txt", &name) == files);
+        CHECK(name == "notes.txt");
+        CHECK(internal::findMountedFiles("/memory.txt", &name) == nullptr);
+
+        CHECK(unmountFiles("/mem/"));
+        CHECK(internal::findMountedFiles("/mem/notes.txt", &name) == nullptr);
+    }
+}
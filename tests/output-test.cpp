@@ -0,0 +1,70 @@
+#include <chrono>
+#include <sstream>
+
+#include "rencpp/ren.hpp"
+
+using namespace ren;
+
+#include "catch.hpp"
+
+TEST_CASE("output buffer test", "[output]")
+{
+    Engine & engine = Engine::runFinder();
+
+    std::stringstream captured;
+    std::ostream & original = engine.setOutputStream(captured);
+    OutputPolicy originalPolicy = engine.getOutputPolicy();
+
+    SECTION("held until threshold")
+    {
+        engine.setOutputPolicy(
+            OutputPolicy {16, std::chrono::milliseconds {60000}}
+        );
+
+        print("abc");
+        CHECK(captured.str().empty());
+
+        // The write that doesn't fit passes on all before it, and itself
+        print("defghijklmnop");
+        CHECK(captured.str() == "abc\ndefghijklmnop");
+
+        engine.flushOutput();
+        CHECK(captured.str() == "abc\ndefghijklmnop\n");
+    }
+
+    SECTION("explicit flush")
+    {
+        engine.setOutputPolicy(
+            OutputPolicy {4096, std::chrono::milliseconds {60000}}
+        );
+
+        print.only("x", 10);
+        CHECK(captured.str().empty());
+
+        engine.flushOutput();
+        CHECK(captured.str() == "x10");
+    }
+
+    SECTION("unbuffered")
+    {
+        engine.setOutputPolicy(OutputPolicy {0});
+
+        print("a", "b");
+        CHECK(captured.str() == "a b\n");
+    }
+
+    SECTION("runtime output")
+    {
+        engine.setOutputPolicy(
+            OutputPolicy {4096, std::chrono::milliseconds {60000}}
+        );
+
+        // Passed on when the evaluation returns, in order with ren::print
+        print.only("before ");
+        runtime("print {during}");
+        CHECK(captured.str() == "before during\n");
+    }
+
+    engine.setOutputPolicy(originalPolicy);
+    engine.setOutputStream(original);
+}
@@ -0,0 +1,86 @@
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "rencpp/ren.hpp"
+#include "rencpp/pool.hpp"
+
+using namespace ren;
+
+#include "catch.hpp"
+
+TEST_CASE("engine pool test", "[rebol] [pool]")
+{
+    // Defined before the pool exists, so every worker has it
+    runtime(
+        "pool-test-die:", Function::construct("", []() { std::_Exit(3); })
+    );
+
+    EnginePool pool {2, 4};
+
+    REQUIRE(pool.size() == 2);
+
+    SECTION("same shape as runtime")
+    {
+        CHECK(static_cast<Integer>(*pool("1 +", 2)) == 3);
+        CHECK(pool("()") == nullopt);
+
+        Block doubled = static_cast<Block>(*pool("map-each x [1 2] [x * 2]"));
+        CHECK(doubled.isEqualTo(Block {"2 4"}));
+
+        CHECK_THROWS_AS(pool("1 / 0"), evaluation_error);
+    }
+
+    SECTION("many submissions")
+    {
+        std::vector<std::future<optional<std::string>>> results;
+        for (int index = 0; index < 20; ++index)
+            results.push_back(pool.submit(std::to_string(index) + " * 10"));
+
+        for (int index = 0; index < 20; ++index)
+            CHECK(*results[static_cast<size_t>(index)].get()
+                == std::to_string(index * 10));
+    }
+
+    SECTION("worker restart")
+    {
+        auto lost = pool.submit("pool-test-die");
+        CHECK_THROWS_AS(lost.get(), worker_lost);
+
+        CHECK(pool.restarts() == 1);
+        CHECK(static_cast<Integer>(*pool("10 + 20")) == 30);
+    }
+}
+
+
+TEST_CASE("engine pool timeout test", "[rebol] [pool]")
+{
+    EnginePool pool {1, 1, std::chrono::milliseconds {200}};
+
+    // The deadline is per job, so a slow one doesn't hold up the next
+    auto stuck = pool.submit("forever []");
+    CHECK_THROWS_AS(stuck.get(), worker_timeout);
+    CHECK(pool.restarts() == 1);
+
+    CHECK(static_cast<Integer>(*pool("1 + 2")) == 3);
+    CHECK(pool.restarts() == 1);
+}
+
+
+TEST_CASE("zygote test", "[rebol] [pool]")
+{
+    Zygote zygote {Block {"zygote-test-base: 100"}};
+
+    SECTION("preloaded and isolated")
+    {
+        CHECK(static_cast<Integer>(*zygote("zygote-test-base + 1")) == 101);
+
+        // Each evaluation starts again from the snapshot
+        zygote("zygote-test-base: 0");
+        CHECK(*zygote.run("zygote-test-base") == "100");
+
+        CHECK_THROWS_AS(zygote.run("1 / 0"), worker_error);
+    }
+}
@@ -1,5 +1,13 @@
 // We only do this if we've built for Rebol
 
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "rencpp/ren.hpp"
+#include "rencpp/memfs.hpp"
 #include "rencpp/rebol.hpp"
 
 using namespace rebol;
@@ -9,4 +17,142 @@ using namespace rebol;
 TEST_CASE("rebol test", "[rebol]")
 {
     runtime.doMagicOnlyRebolCanDo();
+
+    SECTION("startup timings")
+    {
+        runtime("none");
+
+        auto const & timings = runtime.startupTimings();
+        CHECK(timings.total.count() > 0);
+        CHECK(
+            timings.initCore + timings.initExtensions + timings.startMezzanine
+                + timings.patchApply
+            <= timings.total
+        );
+    }
+
+    SECTION("startup scripts")
+    {
+        // Defined by startup-test.reb, which the build embeds
+        CHECK(static_cast<Integer>(*runtime("startup-test-answer")) == 1020);
+        CHECK(static_cast<Integer>(*runtime("startup-test-double 21")) == 42);
+    }
+
+    SECTION("memory files")
+    {
+        auto files = std::make_shared<MemoryFiles>();
+        files->add("input.txt", "some text");
+        mountFiles("/rencpp-test-mem/", files);
+
+        runtime(
+            "write %/rencpp-test-mem/output.txt"
+            " uppercase read/string %/rencpp-test-mem/input.txt"
+        );
+        CHECK(*files->get("output.txt") == std::vector<char>(
+            {'S', 'O', 'M', 'E', ' ', 'T', 'E', 'X', 'T'}
+        ));
+
+        CHECK(static_cast<Logic>(
+            *runtime("exists? %/rencpp-test-mem/output.txt")
+        ));
+
+        unmountFiles("/rencpp-test-mem/");
+    }
+
+    SECTION("load file")
+    {
+        char const * path = "rencpp-load-file-test.reb";
+        {
+            std::ofstream file {path, std::ios::binary};
+            file << "load-file-test: 10 load-file-test + 20";
+        }
+
+        Block loaded = loadFile(path);
+        CHECK(loaded.length() == 5);
+        CHECK(static_cast<Integer>(*runtime.doFile(path)) == 30);
+
+        {
+            std::ofstream file {path, std::ios::binary};
+            file << "[unclosed";
+        }
+        CHECK_THROWS_AS(loadFile(path), load_error);
+
+        std::remove(path);
+        CHECK_THROWS_AS(loadFile(path), std::runtime_error);
+    }
+}
+
+
+TEST_CASE("budget test", "[rebol] [budget]")
+{
+    using std::chrono::steady_clock;
+    using std::chrono::milliseconds;
+
+    SECTION("deadline")
+    {
+        auto start = steady_clock::now();
+        try {
+            runtime.evaluate(
+                {"forever []"}, Budget {start + milliseconds(50)}
+            );
+            FAIL("budget not enforced");
+        }
+        catch (budget_exceeded const & e) {
+            CHECK(e.limit() == BudgetLimit::Deadline);
+        }
+        CHECK(steady_clock::now() - start < milliseconds(1000));
+    }
+
+    SECTION("evaluation steps")
+    {
+        try {
+            runtime.evaluate({"forever []"}, Budget {{}, 1000000});
+            FAIL("budget not enforced");
+        }
+        catch (budget_exceeded const & e) {
+            CHECK(e.limit() == BudgetLimit::EvalSteps);
+        }
+
+        // Within the budget is no different from no budget
+        auto result = runtime.evaluate({"1 + 2"}, Budget {{}, 1000000});
+        CHECK(static_cast<Integer>(*result) == 3);
+    }
+
+    SECTION("memory")
+    {
+        try {
+            runtime.evaluate(
+                {"x: copy [] forever [append x make string! 1000]"},
+                Budget {{}, 0, 10000000}
+            );
+            FAIL("budget not enforced");
+        }
+        catch (budget_exceeded const & e) {
+            CHECK(e.limit() == BudgetLimit::MemoryBytes);
+        }
+        runtime("x: none recycle");
+    }
+
+    SECTION("deadline passing as the evaluation returns")
+    {
+        using std::chrono::microseconds;
+
+        // Deadlines spread around how long a small evaluation takes, so
+        // that some run out just after it has returned but before its
+        // budget is taken down.  Whatever happened to the budgeted one,
+        // the next evaluation must not be halted in its place.
+        for (int delay = 0; delay < 400; ++delay) {
+            try {
+                runtime.evaluate(
+                    {"loop 10 [1 + 2]"},
+                    Budget {steady_clock::now() + microseconds(delay)}
+                );
+            }
+            catch (budget_exceeded const &) {
+            }
+
+            auto result = runtime.evaluate({"1 + 2"});
+            REQUIRE(static_cast<Integer>(*result) == 3);
+        }
+    }
 }
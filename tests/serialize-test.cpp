@@ -0,0 +1,84 @@
+#include <sstream>
+#include <string>
+
+#include "rencpp/ren.hpp"
+#include "rencpp/serialize.hpp"
+
+using namespace ren;
+
+#include "catch.hpp"
+
+TEST_CASE("serialization test", "[rebol] [serialize]")
+{
+    SECTION("round trip")
+    {
+        Block original {
+            "1 -9000000000 2.5 #\"x\" none true"
+            " foo foo: :foo 'foo /foo (a/b) {br{ace}s} <tag> %file.txt"
+            " 1-Jan-2000 http://example.com [nested [deeper]]"
+        };
+
+        std::string bytes = serialize(original);
+        AnyValue loaded = deserialize(bytes);
+
+        CHECK(loaded.isBlock());
+        CHECK(original.isEqualTo(loaded));
+
+        // The same from a stream
+        std::istringstream stream {bytes};
+        CHECK(original.isEqualTo(deserialize(stream)));
+
+        // Each word spelling is only written out once
+        Block words {"alpha alpha alpha: :alpha"};
+        auto size = serialize(words).size();
+        CHECK(size < serialize(Block {"alpha beta gamma: :delta"}).size());
+    }
+
+    SECTION("shared series")
+    {
+        Block inner {"1 2 3"};
+        AnyValue position = *runtime("next", inner);
+
+        Block outer {inner, inner, position};
+        Block loaded = static_cast<Block>(deserialize(serialize(outer)));
+
+        runtime("append", loaded[1], 4);
+        CHECK(runtime("head", loaded[3])->isSameAs(loaded[1]));
+        CHECK(static_cast<Integer>(*runtime("length?", loaded[2])) == 4);
+        CHECK(static_cast<Integer>(*runtime("index?", loaded[3])) == 2);
+    }
+
+    SECTION("binary")
+    {
+        AnyValue binary = *runtime("#{DEADBEEF00}");
+        AnyValue position = *runtime("next", binary);
+
+        Block outer {binary, position};
+        Block loaded = static_cast<Block>(deserialize(serialize(outer)));
+
+        CHECK(outer.isEqualTo(loaded));
+        CHECK(runtime("head", loaded[2])->isSameAs(loaded[1]));
+
+        // The bytes as they are, not the hex of a MOLD
+        AnyValue big = *runtime("append/dup #{} #{AB} 1000");
+        CHECK(serialize(big).size() < 1100);
+        CHECK(big.isEqualTo(deserialize(serialize(big))));
+    }
+
+    SECTION("errors")
+    {
+        Block cycle {"1"};
+        runtime("append/only", cycle, cycle);
+        CHECK_THROWS_AS(serialize(cycle), serialization_error);
+
+        CHECK_THROWS_AS(serialize(*runtime(":print")), serialization_error);
+
+        std::string bytes = serialize(Block {"a b c"});
+        CHECK_THROWS_AS(
+            deserialize(bytes.substr(0, bytes.size() - 1)),
+            serialization_error
+        );
+        CHECK_THROWS_AS(deserialize(bytes + "x"), serialization_error);
+        CHECK_THROWS_AS(deserialize(std::string {"RAN"}), serialization_error);
+    }
+}
@@ -0,0 +1,66 @@
+#include <iostream>
+
+#include "rencpp/ren.hpp"
+
+using namespace ren;
+
+#include "catch.hpp"
+
+TEST_CASE("visit test", "[rebol] [visit]")
+{
+    SECTION("first match wins")
+    {
+        Block randomStuff {"blue", Block {true, 1020}, 3.04};
+
+        auto describe = [](AnyValue const & value) -> std::string {
+            return visit(value,
+                [](Block const & b) { return "block of " + std::to_string(b.length()); },
+                [](AnyWord const &) { return std::string {"word"}; },
+                [](Float const &) { return std::string {"float"}; },
+                [](AnyValue const &) { return std::string {"other"}; }
+            );
+        };
+
+        CHECK(describe(randomStuff) == "block of 3");
+        CHECK(describe(Word {"blue"}) == "word");
+        CHECK(describe(3.04) == "float");
+        CHECK(describe(1020) == "other");
+        CHECK(describe(String {"hello"}) == "other");
+    }
+
+    SECTION("categories")
+    {
+        int arrays = 0;
+        int strings = 0;
+
+        for (auto value : Block {"[a] (b) {c} <d> %e"}) {
+            visit(value,
+                [&](AnyArray const &) { ++arrays; },
+                [&](AnyString const &) { ++strings; }
+            );
+        }
+
+        CHECK(arrays == 2);
+        CHECK(strings == 3);
+    }
+
+    SECTION("agrees with is tests")
+    {
+        // URL! is an AnyString; EMAIL! isn't, so it doesn't match as one
+        for (auto value : Block {"http://example.com someone@example.com"}) {
+            bool matched = visit(value,
+                [](AnyString const &) { return true; },
+                [](AnyValue const &) { return false; }
+            );
+            CHECK(matched == value.isAnyString());
+        }
+    }
+
+    SECTION("no match")
+    {
+        CHECK_THROWS_AS(
+            visit(AnyValue {10}, [](Block const &) {}),
+            bad_value_cast
+        );
+    }
+}
@@ -0,0 +1,61 @@
+//
+// ren-prescan.cpp
+// This file is part of RenCpp
+// Copyright (C) 2015 HostileFork.com
+//
+// Licensed under the Boost License, Version 1.0 (the "License")
+//
+//      http://www.boost.org/LICENSE_1_0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.  See the License for the specific language governing
+// permissions and limitations under the License.
+//
+// See http://rencpp.hostilefork.com for more information on this project
+//
+
+//
+// LOADs a startup script at build time and writes the block as serialize()
+// does, for embed_startup_scripts() in the top-level CMakeLists.txt:
+//
+//     ren-prescan helpers.reb helpers.reb.bin
+//
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "rencpp/ren.hpp"
+#include "rencpp/serialize.hpp"
+
+using namespace ren;
+
+int main(int argc, char ** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: ren-prescan <script> <output>" << std::endl;
+        return 1;
+    }
+
+    try {
+        Block code = Runtime::loadFile(argv[1]);
+
+        std::ofstream output {argv[2], std::ios::binary};
+        serialize(code, output);
+        output.close();
+        if (not output)
+            throw std::runtime_error("couldn't write the output");
+    }
+    catch (std::exception const & e) {
+        std::cerr << "ren-prescan: " << argv[1] << ": " << e.what()
+            << std::endl;
+
+        // Else the build would take a partial output as up to date
+        std::remove(argv[2]);
+        return 1;
+    }
+
+    return 0;
+}